@@ -13,7 +13,7 @@ int main() {
   Arcv::Matrix<float> edgeMat = Arcv::Image::applyFilter<ARCV_FILTER_TYPE_EDGE_ENHANCEMENT>(mat);
   Arcv::Matrix<float> embossMat = Arcv::Image::applyFilter<ARCV_FILTER_TYPE_EMBOSS>(mat);
 
-  Arcv::Sobel sobelMat(mat);
+  Arcv::Sobel<> sobelMat(mat);
 
   Arcv::Image::write(mat, "output.png");
   Arcv::Image::write(blurMat, "outputBlur.png");
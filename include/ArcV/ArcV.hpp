@@ -3,10 +3,20 @@
 #ifndef ARCV_ARCV_HPP
 #define ARCV_ARCV_HPP
 
+#include "ArcV/Math/BitMatrix.hpp"
+#include "ArcV/Math/Fft.hpp"
+#include "ArcV/Math/FilterBank.hpp"
+#include "ArcV/Math/IntegralImage.hpp"
 #include "ArcV/Math/Matrix.hpp"
+#include "ArcV/Math/MemoryArena.hpp"
+#include "ArcV/Math/MatrixView.hpp"
+#include "ArcV/Math/PlanarMatrix.hpp"
+#include "ArcV/Math/StaticKernel.hpp"
 #include "ArcV/Math/Vector.hpp"
 #include "ArcV/Processing/Image.hpp"
 #include "ArcV/Processing/Sobel.hpp"
+#include "ArcV/Utils/ScratchBuffer.hpp"
+#include "ArcV/Utils/ThreadPool.hpp"
 #ifdef __gnu_linux__
 #include "ArcV/Utils/Webcam.hpp"
 #endif
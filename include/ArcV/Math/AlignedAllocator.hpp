@@ -0,0 +1,69 @@
+#pragma once
+
+#ifndef ARCV_ALIGNEDALLOCATOR_HPP
+#define ARCV_ALIGNEDALLOCATOR_HPP
+
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "ArcV/Math/MemoryArena.hpp"
+
+namespace Arcv {
+
+// Cache line size, on which every matrix's storage begins
+constexpr std::size_t ARCV_MEMORY_ALIGNMENT = 64;
+
+// Allocates aligned memory on the heap, or from a memory arena if one is given
+template <typename T, std::size_t Alignment = ARCV_MEMORY_ALIGNMENT>
+class AlignedAllocator {
+  static_assert((Alignment & (Alignment - 1)) == 0, "Error: Alignment must be a power of two");
+
+public:
+  using value_type = T;
+  // Containers keep their own allocator when assigned or swapped, elements being moved into their memory if it differs:
+  //  heap-backed matrices thus never take memory from an arena, which would dangle once it's reset. Copies are always
+  //  made on the heap; containers with different allocators must not be swapped
+  using propagate_on_container_move_assignment = std::false_type;
+  using propagate_on_container_swap = std::false_type;
+
+  template <typename TO> struct rebind { using other = AlignedAllocator<TO, Alignment>; };
+
+  AlignedAllocator() = default;
+  explicit AlignedAllocator(MemoryArena* arena) : arena{ arena } {}
+  template <typename TO> AlignedAllocator(const AlignedAllocator<TO, Alignment>& allocator) : arena{ allocator.getArena() } {}
+
+  MemoryArena* getArena() const { return arena; }
+
+  T* allocate(std::size_t count) const {
+    if (arena)
+      return static_cast<T*>(arena->allocate(count * sizeof(T), Alignment));
+
+    // Over-allocating to both align the block & keep the original address right before it
+    void* rawMemory = ::operator new(count * sizeof(T) + Alignment + sizeof(void*));
+    const std::uintptr_t alignedAddress = (reinterpret_cast<std::uintptr_t>(rawMemory) + sizeof(void*) + Alignment - 1)
+                                          & ~static_cast<std::uintptr_t>(Alignment - 1);
+
+    reinterpret_cast<void**>(alignedAddress)[-1] = rawMemory;
+    return reinterpret_cast<T*>(alignedAddress);
+  }
+
+  // Arena memory is only released when the arena is reset
+  void deallocate(T* memory, std::size_t) const {
+    if (!arena)
+      ::operator delete(reinterpret_cast<void**>(memory)[-1]);
+  }
+
+  AlignedAllocator select_on_container_copy_construction() const { return AlignedAllocator(); }
+
+  template <typename TO> bool operator==(const AlignedAllocator<TO, Alignment>& allocator) const { return arena == allocator.getArena(); }
+  template <typename TO> bool operator!=(const AlignedAllocator<TO, Alignment>& allocator) const { return arena != allocator.getArena(); }
+
+private:
+  MemoryArena* arena = nullptr;
+};
+
+} // namespace Arcv
+
+#endif // ARCV_ALIGNEDALLOCATOR_HPP
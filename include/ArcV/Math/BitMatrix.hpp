@@ -0,0 +1,73 @@
+#pragma once
+
+#ifndef ARCV_BITMATRIX_HPP
+#define ARCV_BITMATRIX_HPP
+
+#include <vector>
+#include <cassert>
+#include <cstdint>
+#include <cstddef>
+
+#include "ArcV/Math/Matrix.hpp"
+#include "ArcV/Math/MatrixView.hpp"
+
+namespace Arcv {
+
+// Single-channel binary mask packing 64 elements per word, element i of a row being bit i % 64 of its (i / 64)-th word;
+//  each row starts on a new word, the bits past the width being kept at 0
+class BitMatrix {
+public:
+  static constexpr std::size_t WordBitCount = 64;
+
+  BitMatrix() = default;
+  BitMatrix(std::size_t width, std::size_t height) { reshape(width, height); }
+  // Sets the elements that are not 0, such as the ones kept by binary thresholding
+  template <typename T> explicit BitMatrix(const Matrix<T>& mat) { pack(mat.getView()); }
+  template <typename T> explicit BitMatrix(const MatrixView<const T>& mat) { pack(mat); }
+
+  std::size_t getWidth() const { return width; }
+  std::size_t getHeight() const { return height; }
+  std::size_t getRowWordCount() const { return rowWordCount; }
+  const std::vector<uint64_t>& getData() const { return data; }
+  std::vector<uint64_t>& getData() { return data; }
+  const uint64_t* getRow(std::size_t heightIndex) const { return data.data() + heightIndex * rowWordCount; }
+  uint64_t* getRow(std::size_t heightIndex) { return data.data() + heightIndex * rowWordCount; }
+
+  bool getBit(std::size_t widthIndex, std::size_t heightIndex) const {
+    assert(("Error: Bit matrix index is out of bounds", widthIndex < width && heightIndex < height));
+    return (getRow(heightIndex)[widthIndex / WordBitCount] >> (widthIndex % WordBitCount)) & 1;
+  }
+  void setBit(std::size_t widthIndex, std::size_t heightIndex, bool value) {
+    assert(("Error: Bit matrix index is out of bounds", widthIndex < width && heightIndex < height));
+    const uint64_t bit = uint64_t(1) << (widthIndex % WordBitCount);
+    uint64_t& word = getRow(heightIndex)[widthIndex / WordBitCount];
+    word = (value ? word | bit : word & ~bit);
+  }
+
+  // Clears every element, reusing the memory already allocated
+  void reshape(std::size_t width, std::size_t height);
+  // Mask of the bits holding elements in a row's last word
+  uint64_t getLastWordMask() const { return (width % WordBitCount == 0 ? ~uint64_t(0) : (uint64_t(1) << (width % WordBitCount)) - 1); }
+
+  template <typename T> void pack(const MatrixView<const T>& mat);
+  // Gives a single-channel matrix whose set elements are 255 & the others 0, as binary thresholding does
+  template <typename T> void unpack(Matrix<T>& res) const;
+  template <typename T = uint8_t> Matrix<T> unpack() const;
+
+private:
+  std::size_t width = 0, height = 0;
+  std::size_t rowWordCount = 0;
+  std::vector<uint64_t> data;
+};
+
+template <typename T>
+Matrix<T> BitMatrix::unpack() const {
+  Matrix<T> res;
+  unpack(res);
+
+  return res;
+}
+
+} // namespace Arcv
+
+#endif // ARCV_BITMATRIX_HPP
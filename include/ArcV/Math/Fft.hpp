@@ -0,0 +1,71 @@
+#pragma once
+
+#ifndef ARCV_FFT_HPP
+#define ARCV_FFT_HPP
+
+#include <vector>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+
+enum FftDirection { ARCV_FFT_DIRECTION_FORWARD = 0,
+                    ARCV_FFT_DIRECTION_INVERSE };
+
+namespace Arcv {
+
+namespace Fft {
+
+// Twiddle factors & bit-reversed permutation of radix-2 complex transforms of a given power of 2 size, along with the
+//  twiddles recombining the halves of real transforms of twice that size; built once per size & shared by getPlan()
+class Plan {
+public:
+  explicit Plan(std::size_t size);
+  Plan(const Plan&) = delete;
+  Plan& operator=(const Plan&) = delete;
+
+  std::size_t getSize() const { return size; }
+
+  // Transforms in place batchSize sequences of size complex values, the n-th values of all of them lying contiguously
+  //  rowStride values after the (n - 1)-th ones; neither direction is normalized, the inverse transform giving back size
+  //  times the original values
+  void transform(std::complex<float>* data, std::size_t rowStride, std::size_t batchSize, FftDirection direction) const;
+  void transform(std::complex<float>* data, FftDirection direction) const { transform(data, 1, 1, direction); }
+
+  // Transforms 2 * size real values into the size + 1 first complex values of their spectrum, the others being their
+  //  conjugates; the inverse transform destroys its input & gives back 2 * size times the original values
+  void transformReal(const float* input, std::complex<float>* output) const;
+  void inverseTransformReal(std::complex<float>* input, float* output) const;
+  // Same as transformReal() on batchSize sequences laid out as for transform(), the size first rows of data holding their
+  //  even & odd values as real & imaginary parts, replaced by the size + 1 first values of their spectra
+  void transformPackedReal(std::complex<float>* data, std::size_t batchSize) const;
+  void inverseTransformPackedReal(std::complex<float>* data, std::size_t batchSize) const;
+
+private:
+  std::size_t size;
+  std::vector<uint32_t> bitReversedIndices;
+  std::vector<std::complex<float>> twiddles;        // Stages' exp(-i * pi * k / halfLength), k < halfLength
+  std::vector<std::complex<float>> inverseTwiddles; // Conjugates of the above
+  std::vector<std::complex<float>> realTwiddles;    // exp(-2i * pi * k / (2 * size)), k <= size / 2
+};
+
+// Smallest transform size, a power of 2, holding at least size values
+std::size_t computeTransformSize(std::size_t size);
+// Plan of complex transforms of the given power of 2 size, thus of real transforms of twice that size; plans are kept
+//  for the program's lifetime & may be used concurrently
+const Plan& getPlan(std::size_t size);
+
+// Transforms height rows of width real values, inputStride apart, into height rows of width / 2 + 1 complex values; width
+//  & height must be powers of 2, rows & columns being transformed by several threads
+void transformReal2D(const float* input, std::size_t inputStride, std::size_t width, std::size_t height,
+                     std::complex<float>* output);
+// Inverse of transformReal2D(), destroying its input & giving back width * height times the original values
+void inverseTransformReal2D(std::complex<float>* input, std::size_t width, std::size_t height, float* output,
+                            std::size_t outputStride);
+// Computes spectrum[i] *= factors[i] on count values, which filters a signal in the frequency domain
+void multiplySpectra(std::complex<float>* spectrum, const std::complex<float>* factors, std::size_t count);
+
+} // namespace Fft
+
+} // namespace Arcv
+
+#endif // ARCV_FFT_HPP
@@ -0,0 +1,56 @@
+#pragma once
+
+#ifndef ARCV_FILTERBANK_HPP
+#define ARCV_FILTERBANK_HPP
+
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <complex>
+#include <cstddef>
+
+#include "ArcV/Math/Matrix.hpp"
+#include "ArcV/Math/MatrixView.hpp"
+
+namespace Arcv {
+
+// Kernels applied together to the same matrices by applyFilterBank(), like banks of oriented filters run on every frame
+//  of a video; each must be square & of odd size
+// Kernels of at least 17x17 that are not separable are applied in the frequency domain, their spectra being kept between
+//  calls as long as the matrices' sizes don't change; a bank may be applied from several threads at once
+class FilterBank {
+public:
+  using Spectra = std::vector<std::vector<std::complex<float>>>;
+
+  explicit FilterBank(std::vector<Matrix<float>> kernels);
+
+  std::size_t getKernelCount() const { return kernels.size(); }
+  const Matrix<float>& getKernel(std::size_t index) const { return kernels[index]; }
+  bool isTransformed(std::size_t index) const { return transformedKernels[index]; }
+  // Radius by which matrices are bordered before being transformed, the largest among the transformed kernels
+  std::size_t getTransformRadius() const { return transformRadius; }
+
+  // Spectra of the transformed kernels correlating matrices bordered by the transform radius & padded to the given sizes,
+  //  indexed as the kernels & computed on the first call for these sizes; calls for other sizes replace them without
+  //  altering those already given, which callers keep using until they release them
+  std::shared_ptr<const Spectra> getSpectra(std::size_t transformWidth, std::size_t transformHeight);
+
+private:
+  std::vector<Matrix<float>> kernels;
+  std::vector<bool> transformedKernels;
+  std::size_t transformRadius = 0;
+  std::mutex spectraMutex;
+  std::size_t spectraWidth = 0, spectraHeight = 0;    // Transform sizes the spectra have been computed for
+  std::shared_ptr<const Spectra> spectra;
+};
+
+// Gives the responses to every kernel of the bank, as convolve() would; the matrix is read & transformed once for all
+//  transformed kernels, each of them then costing a product of spectra & an inverse transform per channel
+template <typename T> std::vector<Matrix<T>> applyFilterBank(const MatrixView<const T>& mat, FilterBank& bank,
+                                                             BorderType border = ARCV_BORDER_TYPE_CONSTANT, float borderValue = 0.f);
+template <typename TI, typename TO> void applyFilterBank(const MatrixView<const TI>& mat, FilterBank& bank, std::vector<Matrix<TO>>& responses,
+                                                         BorderType border = ARCV_BORDER_TYPE_CONSTANT, float borderValue = 0.f);
+
+} // namespace Arcv
+
+#endif // ARCV_FILTERBANK_HPP
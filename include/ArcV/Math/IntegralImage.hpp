@@ -0,0 +1,87 @@
+#pragma once
+
+#ifndef ARCV_INTEGRALIMAGE_HPP
+#define ARCV_INTEGRALIMAGE_HPP
+
+#include <vector>
+#include <cassert>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+#include "ArcV/Math/Matrix.hpp"
+#include "ArcV/Math/MatrixView.hpp"
+
+namespace Arcv {
+
+// Type accumulating sums of T elements, wide enough for the squares of a whole matrix's integer elements
+template <typename T> using IntegralSum = std::conditional_t<std::is_integral<T>::value, int64_t, double>;
+
+// Summed-area table of a matrix, giving the sum of any rectangle's elements in O(1): it has a row & a column more than
+//  the matrix, its element (x, y) holding the sum of the matrix's elements above & to the left of (x, y), excluded
+// Sums of squared elements can be kept as well, from which rectangles' variances are given
+template <typename T>
+class IntegralImage {
+public:
+  using SumType = IntegralSum<T>;
+
+  IntegralImage() = default;
+  explicit IntegralImage(const MatrixView<const T>& mat, bool withSquaredSums = false) { compute(mat, withSquaredSums); }
+
+  std::size_t getWidth() const { return width; }
+  std::size_t getHeight() const { return height; }
+  uint8_t getChannelCount() const { return channelCount; }
+  bool hasSquaredSums() const { return !squaredSums.empty(); }
+  const std::vector<SumType>& getSums() const { return sums; }
+  const std::vector<SumType>& getSquaredSums() const { return squaredSums; }
+
+  // Builds the tables of the given matrix, reusing the memory already allocated; rows are split among threads
+  void compute(const MatrixView<const T>& mat, bool withSquaredSums = false);
+
+  // Rectangles span the columns [widthBegin, widthEnd) & the rows [heightBegin, heightEnd) of the matrix
+  SumType computeSum(std::size_t widthBegin, std::size_t widthEnd, std::size_t heightBegin, std::size_t heightEnd, uint8_t chan = 0) const {
+    return computeRectangleSum(sums, widthBegin, widthEnd, heightBegin, heightEnd, chan);
+  }
+  SumType computeSquaredSum(std::size_t widthBegin, std::size_t widthEnd, std::size_t heightBegin, std::size_t heightEnd, uint8_t chan = 0) const {
+    assert(("Error: Integral image has no squared sums", hasSquaredSums()));
+    return computeRectangleSum(squaredSums, widthBegin, widthEnd, heightBegin, heightEnd, chan);
+  }
+  double computeMean(std::size_t widthBegin, std::size_t widthEnd, std::size_t heightBegin, std::size_t heightEnd, uint8_t chan = 0) const;
+  // Population variance, which needs the squared sums
+  double computeVariance(std::size_t widthBegin, std::size_t widthEnd, std::size_t heightBegin, std::size_t heightEnd, uint8_t chan = 0) const;
+
+private:
+  SumType computeRectangleSum(const std::vector<SumType>& table, std::size_t widthBegin, std::size_t widthEnd,
+                              std::size_t heightBegin, std::size_t heightEnd, uint8_t chan) const {
+    assert(("Error: Integral image rectangle is out of bounds", widthBegin <= widthEnd && widthEnd <= width
+                                                                && heightBegin <= heightEnd && heightEnd <= height));
+
+    const std::size_t tableStride = (width + 1) * channelCount;
+    const SumType* beginRow = table.data() + heightBegin * tableStride + chan;
+    const SumType* endRow = table.data() + heightEnd * tableStride + chan;
+
+    return endRow[widthEnd * channelCount] - endRow[widthBegin * channelCount]
+         - beginRow[widthEnd * channelCount] + beginRow[widthBegin * channelCount];
+  }
+
+  std::size_t width = 0, height = 0;
+  uint8_t channelCount = 1;
+  std::vector<SumType> sums;
+  std::vector<SumType> squaredSums;
+};
+
+// Averages the kernelWidth x kernelHeight neighbourhood of every element, as convolve() would with a kernel of constant
+//  weights, integer results being rounded to the nearest; sizes must be odd. Each element costs 4 lookups into the
+//  integral image of the bordered matrix, whatever the sizes
+template <typename T> Matrix<T> boxFilter(const MatrixView<const T>& mat, std::size_t kernelWidth, std::size_t kernelHeight,
+                                          BorderType border = ARCV_BORDER_TYPE_CONSTANT, float borderValue = 0.f);
+template <typename TI, typename TO> void boxFilter(const MatrixView<const TI>& mat, std::size_t kernelWidth, std::size_t kernelHeight,
+                                                   Matrix<TO>& res, BorderType border = ARCV_BORDER_TYPE_CONSTANT, float borderValue = 0.f);
+// Gives the means & population variances of every element's neighbourhood in a single pass over the integral images
+template <typename T> void computeLocalStatistics(const MatrixView<const T>& mat, std::size_t kernelWidth, std::size_t kernelHeight,
+                                                  Matrix<float>& means, Matrix<float>& variances,
+                                                  BorderType border = ARCV_BORDER_TYPE_CONSTANT, float borderValue = 0.f);
+
+} // namespace Arcv
+
+#endif // ARCV_INTEGRALIMAGE_HPP
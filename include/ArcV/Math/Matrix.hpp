@@ -6,6 +6,13 @@
 #include <cmath>
 #include <vector>
 #include <cstdint>
+#include <functional>
+#include <type_traits>
+
+#include "ArcV/Math/AlignedAllocator.hpp"
+#include "ArcV/Math/MatrixExpression.hpp"
+#include "ArcV/Math/Simd.hpp"
+#include "ArcV/Utils/ThreadPool.hpp"
 
 enum Colorspace { ARCV_COLORSPACE_GRAY = 0,
                   ARCV_COLORSPACE_RGB,
@@ -13,30 +20,74 @@ enum Colorspace { ARCV_COLORSPACE_GRAY = 0,
                   ARCV_COLORSPACE_GRAY_ALPHA,
                   ARCV_COLORSPACE_RGBA };
 
+// Determines the values of elements lying out of a matrix, as needed by convolutions near its edges: CONSTANT takes a
+//  given value, REPLICATE repeats the edge element (aa|abcd|dd), REFLECT mirrors around it (cb|abcd|cb) & WRAP repeats
+//  the whole matrix (cd|abcd|ab)
+enum BorderType { ARCV_BORDER_TYPE_CONSTANT = 0,
+                  ARCV_BORDER_TYPE_REPLICATE,
+                  ARCV_BORDER_TYPE_REFLECT,
+                  ARCV_BORDER_TYPE_WRAP };
+
 namespace Arcv {
 
+template <typename T> class MatrixView;
+template <typename T> class PlanarMatrix;
+
+// Statistics of a single channel, the variance being the population one
+template <typename T>
+struct ChannelStatistics {
+  T min;
+  T max;
+  double sum;
+  double mean;
+  double variance;
+};
+
+// Channel count known at compile time, handed to pixel kernels so that their per-channel loops can be unrolled;
+//  ChannelCount<0> stands for any other count, which is then only known at runtime
+template <uint8_t N>
+struct ChannelCount : std::integral_constant<uint8_t, N> {
+  constexpr uint8_t operator()(uint8_t) const { return N; }
+};
+
+template <>
+struct ChannelCount<0> : std::integral_constant<uint8_t, 0> {
+  constexpr uint8_t operator()(uint8_t channelCount) const { return channelCount; }
+};
+
+// Calls func with ChannelCount<1> to ChannelCount<4> matching channelCount, or with ChannelCount<0> for larger counts
+template <typename Func> void dispatchChannelCount(uint8_t channelCount, Func&& func);
+
 template <typename T = float>
-class Matrix {
+class Matrix : public MatrixExpression<Matrix<T>> {
 public:
+  using ValueType = T;
+
   Matrix() = default;
+  explicit Matrix(const AlignedAllocator<T>& allocator) : data(allocator) {}
 
   Matrix(std::size_t width,
          std::size_t height)
-    : width{ width }, height{ height }, data(width * height) {}
+    : width{ width }, height{ height }, stride{ width }, data(width * height) {}
 
   Matrix(std::size_t width,
          std::size_t height,
          uint8_t channels,
          uint8_t bitDepth,
-         Colorspace colorspace)
+         Colorspace colorspace,
+         bool padRows = false)
     : width{ width },
       height{ height },
       channelCount{ channels },
       imgBitDepth{ bitDepth },
       colorspace{ colorspace },
-      data(width * height * channels) {}
+      paddedRows{ padRows },
+      stride{ computeStride(width, channels, padRows) },
+      data(stride * height) {}
 
   template <typename TI> Matrix(const Matrix<TI>& mat);
+  template <typename TI> explicit Matrix(const MatrixView<TI>& view);
+  template <typename E> Matrix(const MatrixExpression<E>& expr);
 
   Matrix(std::initializer_list<std::initializer_list<T>> list);
 
@@ -45,25 +96,34 @@ public:
   uint8_t getImgBitDepth() const { return imgBitDepth; }
   uint8_t getChannelCount() const { return channelCount; }
   Colorspace getColorspace() const { return colorspace; }
-  const std::vector<T>& getData() const { return data; }
-  std::vector<T>& getData() { return data; }
-
-  void setChannelCount(uint8_t channelCount) { this->channelCount = channelCount; }
+  std::size_t getStride() const { return stride; }
+  bool hasPaddedRows() const { return paddedRows; }
+  AlignedAllocator<T> getAllocator() const { return data.get_allocator(); }
+  const std::vector<T, AlignedAllocator<T>>& getData() const { return data; }
+  std::vector<T, AlignedAllocator<T>>& getData() { return data; }
+  MatrixView<const T> getView() const { return *this; }
+  MatrixView<T> getView() { return *this; }
+
+  // Row stride follows the channel count, but pixels are left for the caller to rearrange
+  void setChannelCount(uint8_t channelCount) {
+    this->channelCount = channelCount;
+    stride = computeStride(width, channelCount, paddedRows);
+  }
   void setColorspace(Colorspace colorspace) { this->colorspace = colorspace; }
-
-  Matrix convolve(const Matrix<float>& convMat) const;
+  // Reuses the already allocated memory whenever it is large enough; elements' values are then unspecified
+  void reshape(std::size_t width, std::size_t height, uint8_t channels, uint8_t bitDepth, Colorspace colorspace, bool padRows);
+  template <typename TI> void copyFrom(const MatrixView<TI>& view);
+  // Stores mat * scale + offset, saturated to T; large matrices are converted by several threads
+  template <typename TI> void convertFrom(const Matrix<TI>& mat, float scale = 1.f, float offset = 0.f);
+
+  Matrix convolve(const Matrix<float>& convMat, BorderType border = ARCV_BORDER_TYPE_CONSTANT, float borderValue = 0.f) const;
+  // Gathers every channel's statistics in a single multithreaded pass
+  std::vector<ChannelStatistics<T>> computeStatistics() const;
   std::pair<T, T> determineBoundaries() const;
   std::vector<T> computeAverageValues() const;
   std::vector<T> computeStandardDeviations() const;
 
-  Matrix operator+(Matrix mat);
-  Matrix operator+(float val);
-  Matrix operator-(Matrix mat);
-  Matrix operator-(float val);
-  Matrix operator*(Matrix mat);
-  Matrix operator*(float val);
-  Matrix operator/(Matrix mat);
-  Matrix operator/(float val);
+  template <typename E> Matrix& operator=(const MatrixExpression<E>& expr);
   Matrix& operator+=(const Matrix& mat);
   Matrix& operator+=(float val);
   Matrix& operator-=(const Matrix& mat);
@@ -72,24 +132,66 @@ public:
   Matrix& operator*=(float val);
   Matrix& operator/=(const Matrix& mat);
   Matrix& operator/=(float val);
-  const T& operator()(std::size_t widthIndex, std::size_t heightIndex) const { return data[heightIndex * width + widthIndex]; }
-  T& operator()(std::size_t widthIndex, std::size_t heightIndex) { return data[heightIndex * width + widthIndex]; }
+  // Gives the first channel of the pixel at (widthIndex, heightIndex), skipping rows' padding, its other channels
+  //  following it; flat elements, padding included, are given by operator[]
+  const T& operator()(std::size_t widthIndex, std::size_t heightIndex) const { return data[heightIndex * stride + widthIndex * channelCount]; }
+  T& operator()(std::size_t widthIndex, std::size_t heightIndex) { return data[heightIndex * stride + widthIndex * channelCount]; }
   const T& operator[](std::size_t index) const { return data[index]; }
   T& operator[](std::size_t index) { return data[index]; } // Implement Pixel class to return an instance?
 
 private:
-  std::size_t width, height;
+  template <typename> friend class PlanarMatrix;
+
+  static std::size_t computeStride(std::size_t width, uint8_t channels, bool padRows);
+  // Rows are processed separately, so that padding elements are left untouched
+  template <ElementwiseOperation Op> Matrix& applyElementwise(const Matrix& mat);
+  template <ElementwiseOperation Op> Matrix& applyElementwise(float val);
+
+  std::size_t width = 0, height = 0;
   uint8_t channelCount = 1, imgBitDepth = 8;    // TODO: channels, depth & colorspace have nothing to do with general matrices
   Colorspace colorspace = ARCV_COLORSPACE_GRAY;
-  std::vector<T> data;
+  bool paddedRows = false;
+  std::size_t stride = 0;                       // Amount of elements between two rows' beginnings
+  std::vector<T, AlignedAllocator<T>> data;
 };
 
-template <> Matrix<> Matrix<>::convolve(const Matrix<float>& convMat) const;
+// Integer pixels are convolved in fixed point, the kernel's weights being rounded to a multiple of 1/4096 for
+//  uint8_t & of 1/256 for int16_t inputs; the sum of their absolute values must then stay below 2048 & 256 respectively
+// Rounded weights are adjusted to add up to the kernel's rounded sum, normalized kernels keeping uniform areas unchanged
+// Kernels of rank 1 are detected & applied as a row & a column kernel, as done by convolveSeparable(); other kernels of
+//  at least 25x25 are applied through FFTs in floating point, integer results being rounded to the nearest
+// Neighbours lying out of the matrix are given by the border type, the constant one filling them with borderValue
+// Large matrices are split into cache-sized tiles, convolved by several threads
+template <typename T> Matrix<T> convolve(const MatrixView<const T>& mat, const Matrix<float>& convMat,
+                                         BorderType border = ARCV_BORDER_TYPE_CONSTANT, float borderValue = 0.f);
+template <typename TI, typename TO> void convolve(const MatrixView<const TI>& mat, const Matrix<float>& convMat, Matrix<TO>& res,
+                                                  BorderType border = ARCV_BORDER_TYPE_CONSTANT, float borderValue = 0.f);
+// Convolves with the outer product of a column & a row kernel, each given as a single row or column of odd size, costing
+//  O(2k) operations per element instead of O(k^2); integer pixels' intermediate results are rounded to a multiple of 1/16
+//  for uint8_t & to integers for int16_t inputs, the column kernel's weights then being rounded to a multiple of 1/256;
+//  each kernel's rounded weights add up to its rounded sum, as those of convolve()
+template <typename T> Matrix<T> convolveSeparable(const MatrixView<const T>& mat, const Matrix<float>& rowKernel,
+                                                  const Matrix<float>& columnKernel, BorderType border = ARCV_BORDER_TYPE_CONSTANT,
+                                                  float borderValue = 0.f);
+template <typename TI, typename TO> void convolveSeparable(const MatrixView<const TI>& mat, const Matrix<float>& rowKernel,
+                                                           const Matrix<float>& columnKernel, Matrix<TO>& res,
+                                                           BorderType border = ARCV_BORDER_TYPE_CONSTANT, float borderValue = 0.f);
+
+// Type of the weighted sums convolving TI elements, integer ones being convolved in fixed point
+template <typename T> using ConvolutionSum = std::conditional_t<std::is_integral<T>::value, int32_t, float>;
+// Convolution engine behind convolve(), taking care of tiles, threads & borders: each result row is given by
+//  computeSums(rows, sums, count, offsets), which sums the count elements of bordered rows shifted by offsets, holding
+//  the positions of the kernelSize^2 taps row by row; sums are then divided by 2^fractionBits, rounded & saturated
+template <typename TI, typename TO>
+void convolveRows(const MatrixView<const TI>& mat, std::size_t kernelSize, uint8_t fractionBits,
+                  const std::function<void(const TI*, ConvolutionSum<TI>*, std::size_t, const std::ptrdiff_t*)>& computeSums,
+                  const MatrixView<TO>& res, BorderType border = ARCV_BORDER_TYPE_CONSTANT, float borderValue = 0.f);
 
 using Mat = Matrix<>;
 
 } // namespace Arcv
 
+#include "ArcV/Math/MatrixView.hpp"
 #include "ArcV/Math/Matrix.inl"
 
 #endif // ARCV_MATRIX_HPP
@@ -6,21 +6,43 @@
 
 namespace Arcv {
 
+template <typename Func>
+void dispatchChannelCount(uint8_t channelCount, Func&& func) {
+  switch (channelCount) {
+    case 1: func(ChannelCount<1>()); break;
+    case 2: func(ChannelCount<2>()); break;
+    case 3: func(ChannelCount<3>()); break;
+    case 4: func(ChannelCount<4>()); break;
+    default: func(ChannelCount<0>()); break;
+  }
+}
+
 template <typename T>
 template <typename TI>
-Matrix<T>::Matrix(const Matrix<TI>& mat) : Matrix(mat.getWidth(),
-                                                  mat.getHeight(),
-                                                  mat.getChannelCount(),
-                                                  mat.getImgBitDepth(),
-                                                  mat.getColorspace()) {
-  if (std::numeric_limits<TI>::max() > std::numeric_limits<T>::max()) {
-    for (std::size_t eltIndex = 0; eltIndex < mat.getData().size(); ++eltIndex) {
-      data[eltIndex] = std::max(static_cast<TI>(std::numeric_limits<T>::min()),
-                                std::min(static_cast<TI>(std::numeric_limits<T>::max()),
-                                         static_cast<TI>(mat.getData()[eltIndex])));
-    }
-  } else {
-    std::copy(mat.getData().cbegin(), mat.getData().cend(), data.begin());
+Matrix<T>::Matrix(const Matrix<TI>& mat) : paddedRows{ mat.hasPaddedRows() } {
+  convertFrom(mat);
+}
+
+template <typename T>
+template <typename TI>
+Matrix<T>::Matrix(const MatrixView<TI>& view) {
+  copyFrom(view);
+}
+
+template <typename T>
+template <typename E>
+Matrix<T>::Matrix(const MatrixExpression<E>& expr) : Matrix(expr.getDerived().getWidth(),
+                                                            expr.getDerived().getHeight(),
+                                                            expr.getDerived().getChannelCount(),
+                                                            expr.getDerived().getImgBitDepth(),
+                                                            expr.getDerived().getColorspace(),
+                                                            expr.getDerived().hasPaddedRows()) {
+  const E& exprRes = expr.getDerived();
+  const std::size_t rowLength = width * channelCount;
+
+  for (std::size_t heightIndex = 0; heightIndex < height; ++heightIndex) {
+    for (std::size_t eltIndex = heightIndex * stride; eltIndex < heightIndex * stride + rowLength; ++eltIndex)
+      data[eltIndex] = static_cast<T>(exprRes[eltIndex]);
   }
 }
 
@@ -39,178 +61,262 @@ Matrix<T>::Matrix(std::initializer_list<std::initializer_list<T>> list)
 }
 
 template <typename T>
-std::pair<T, T> Matrix<T>::determineBoundaries() const {
-  std::pair<T, T> bounds;
+std::size_t Matrix<T>::computeStride(std::size_t width, uint8_t channels, bool padRows) {
+  const std::size_t rowLength = width * channels;
 
-  for (const auto& it : data) {
-    if (it < bounds.first)
-      bounds.first = it;
-    else if (it > bounds.second)
-      bounds.second = it;
-  }
+  if (!padRows)
+    return rowLength;
 
-  return bounds;
+  // Rounding up to the next multiple of the alignment, so that each row begins on an aligned address
+  const std::size_t alignedEltCount = std::max(ARCV_MEMORY_ALIGNMENT / sizeof(T), static_cast<std::size_t>(1));
+  return (rowLength + alignedEltCount - 1) / alignedEltCount * alignedEltCount;
 }
 
 template <typename T>
-std::vector<T> Matrix<T>::computeAverageValues() const {
-  std::vector<T> res(channelCount);
-  std::vector<long double> values(channelCount);
+void Matrix<T>::reshape(std::size_t width, std::size_t height, uint8_t channels, uint8_t bitDepth,
+                        Colorspace colorspace, bool padRows) {
+  this->width = width;
+  this->height = height;
+  this->channelCount = channels;
+  this->imgBitDepth = bitDepth;
+  this->colorspace = colorspace;
+  this->paddedRows = padRows;
+  this->stride = computeStride(width, channels, padRows);
+
+  data.resize(stride * height);
+}
 
-  for (std::size_t heightIndex = 0; heightIndex < height; ++heightIndex) {
-    for (std::size_t widthIndex = 0; widthIndex < width; ++widthIndex) {
-      const std::size_t matIndex = (heightIndex * width + widthIndex) * channelCount;
+template <typename T>
+template <typename TI>
+void Matrix<T>::copyFrom(const MatrixView<TI>& view) {
+  reshape(view.getWidth(), view.getHeight(), view.getChannelCount(), view.getImgBitDepth(), view.getColorspace(), paddedRows);
 
-      for (uint8_t chan = 0; chan < channelCount; ++chan)
-        values[chan] += data[matIndex + chan];
-    }
-  }
+  const std::size_t rowLength = view.getRowLength();
+
+  for (std::size_t heightIndex = 0; heightIndex < height; ++heightIndex)
+    std::copy(view.getRow(heightIndex), view.getRow(heightIndex) + rowLength, data.begin() + heightIndex * stride);
+}
 
-  const std::size_t nbPixels = width * height;
-  std::transform(values.cbegin(), values.cend(), res.begin(), std::bind2nd(std::divides<T>(), nbPixels));
+template <typename T>
+Matrix<T> Matrix<T>::convolve(const Matrix<float>& convMat, BorderType border, float borderValue) const {
+  Matrix res(width, height, channelCount, imgBitDepth, colorspace, paddedRows);
+  Arcv::convolve(getView(), convMat, res, border, borderValue);
 
   return res;
 }
 
 template <typename T>
-std::vector<T> Matrix<T>::computeStandardDeviations() const {
-  const std::vector<T> avgValues = computeAverageValues();
-  std::vector<T> res(channelCount);
-  std::vector<long double> values(channelCount);
+template <typename TI>
+void Matrix<T>::convertFrom(const Matrix<TI>& mat, float scale, float offset) {
+  reshape(mat.getWidth(), mat.getHeight(), mat.getChannelCount(), mat.getImgBitDepth(), mat.getColorspace(), paddedRows);
 
-  for (std::size_t heightIndex = 0; heightIndex < height; ++heightIndex) {
-    for (std::size_t widthIndex = 0; widthIndex < width; ++widthIndex) {
-      const std::size_t matIndex = (heightIndex * width + widthIndex) * channelCount;
+  // Rows are grouped in blocks large enough to be worth a thread each
+  const std::size_t rowLength = width * channelCount;
+  const std::size_t blockHeight = std::max<std::size_t>(1, (1 << 16) / std::max<std::size_t>(1, rowLength));
+
+  ThreadPool::getInstance().parallelFor((height + blockHeight - 1) / blockHeight, [&] (std::size_t blockBegin, std::size_t blockEnd) {
+    const std::size_t heightEnd = std::min(blockEnd * blockHeight, height);
+
+    for (std::size_t heightIndex = blockBegin * blockHeight; heightIndex < heightEnd; ++heightIndex)
+      Simd::convert(mat.getData().data() + heightIndex * mat.getStride(), data.data() + heightIndex * stride, rowLength, scale, offset);
+  });
+}
 
-      for (uint8_t chan = 0; chan < channelCount; ++chan) {
-        const std::size_t value = data[matIndex + chan] - avgValues[chan];
+template <typename T>
+std::vector<ChannelStatistics<T>> Matrix<T>::computeStatistics() const {
+  assert(("Error: Statistics cannot be computed on an empty matrix", width > 0 && height > 0));
+
+  // Rows are split into ranges large enough to be worth a thread each
+  const std::size_t minRangeHeight = std::max<std::size_t>(1, (1 << 16) / (width * channelCount));
+  const std::size_t rangeCount = std::min((height + minRangeHeight - 1) / minRangeHeight, ThreadPool::getInstance().getThreadCount());
+  // Ranges are split proportionally, so that none of them is left empty
+  const auto getRangeBegin = [&] (std::size_t rangeIndex) { return rangeIndex * height / rangeCount; };
+
+  std::vector<T> mins(rangeCount * channelCount, std::numeric_limits<T>::max());
+  std::vector<T> maxs(rangeCount * channelCount, std::numeric_limits<T>::lowest());
+  std::vector<double> shifts(rangeCount * channelCount);
+  std::vector<double> sums(rangeCount * channelCount);
+  std::vector<double> squaredSums(rangeCount * channelCount);
+
+  ThreadPool::getInstance().parallelFor(rangeCount, [&] (std::size_t rangeBegin, std::size_t rangeEnd) {
+    for (std::size_t rangeIndex = rangeBegin; rangeIndex < rangeEnd; ++rangeIndex) {
+      const std::size_t channelIndex = rangeIndex * channelCount;
+      const std::size_t heightBegin = getRangeBegin(rangeIndex);
+      const std::size_t heightEnd = getRangeBegin(rangeIndex + 1);
+
+      // Values are shifted by the range's first pixel, which is usually close enough to the mean
+      for (uint8_t chan = 0; chan < channelCount; ++chan)
+        shifts[channelIndex + chan] = data[heightBegin * stride + chan];
 
-        values[chan] += value * value;
+      for (std::size_t heightIndex = heightBegin; heightIndex < heightEnd; ++heightIndex) {
+        Simd::accumulateStatistics(data.data() + heightIndex * stride, width, channelCount, &shifts[channelIndex],
+                                   &mins[channelIndex], &maxs[channelIndex], &sums[channelIndex], &squaredSums[channelIndex]);
       }
     }
-  }
+  });
+
+  // Merging ranges' results with Chan et al.'s pairwise formula
+  std::vector<ChannelStatistics<T>> res(channelCount);
+
+  for (uint8_t chan = 0; chan < channelCount; ++chan) {
+    ChannelStatistics<T>& stats = res[chan];
+    stats = { mins[chan], maxs[chan], 0.0, 0.0, 0.0 };
 
-  const std::size_t nbPixels = width * height;
-  for (std::size_t i = 0; i < res.size(); ++i)
-    res[i] = std::sqrt(values[i] / nbPixels);
+    double pixelCount = 0.0;
+    double squaredDeviations = 0.0;
+
+    for (std::size_t rangeIndex = 0; rangeIndex < rangeCount; ++rangeIndex) {
+      const std::size_t channelIndex = rangeIndex * channelCount + chan;
+      const double rangePixelCount = static_cast<double>((getRangeBegin(rangeIndex + 1) - getRangeBegin(rangeIndex)) * width);
+      const double rangeMean = shifts[channelIndex] + sums[channelIndex] / rangePixelCount;
+      const double rangeSquaredDeviations = squaredSums[channelIndex] - sums[channelIndex] * sums[channelIndex] / rangePixelCount;
+
+      const double delta = rangeMean - stats.mean;
+      const double totalPixelCount = pixelCount + rangePixelCount;
+
+      stats.mean += delta * rangePixelCount / totalPixelCount;
+      squaredDeviations += rangeSquaredDeviations + delta * delta * pixelCount * rangePixelCount / totalPixelCount;
+      pixelCount = totalPixelCount;
+
+      stats.min = std::min(stats.min, mins[channelIndex]);
+      stats.max = std::max(stats.max, maxs[channelIndex]);
+      stats.sum += shifts[channelIndex] * rangePixelCount + sums[channelIndex];
+    }
+
+    stats.variance = std::max(squaredDeviations, 0.0) / pixelCount;
+  }
 
   return res;
 }
 
 template <typename T>
-Matrix<T> Matrix<T>::operator+(Matrix mat) {
-  mat += *this;
-  return mat;
+std::pair<T, T> Matrix<T>::determineBoundaries() const {
+  const std::vector<ChannelStatistics<T>> stats = computeStatistics();
+  std::pair<T, T> bounds(stats.front().min, stats.front().max);
+
+  for (const ChannelStatistics<T>& chanStats : stats) {
+    bounds.first = std::min(bounds.first, chanStats.min);
+    bounds.second = std::max(bounds.second, chanStats.max);
+  }
+
+  return bounds;
 }
 
 template <typename T>
-Matrix<T> Matrix<T>::operator+(float val) {
-  Matrix<T> res = *this;
-  res += val;
+std::vector<T> Matrix<T>::computeAverageValues() const {
+  const std::vector<ChannelStatistics<T>> stats = computeStatistics();
+  std::vector<T> res(channelCount);
+
+  for (uint8_t chan = 0; chan < channelCount; ++chan)
+    res[chan] = static_cast<T>(stats[chan].mean);
+
   return res;
 }
 
 template <typename T>
-Matrix<T> Matrix<T>::operator-(Matrix mat) {
-  mat -= *this;
-  return mat;
-}
+std::vector<T> Matrix<T>::computeStandardDeviations() const {
+  const std::vector<ChannelStatistics<T>> stats = computeStatistics();
+  std::vector<T> res(channelCount);
+
+  for (uint8_t chan = 0; chan < channelCount; ++chan)
+    res[chan] = static_cast<T>(std::sqrt(stats[chan].variance));
 
-template <typename T>
-Matrix<T> Matrix<T>::operator-(float val) {
-  Matrix<T> res = *this;
-  res -= val;
   return res;
 }
 
 template <typename T>
-Matrix<T> Matrix<T>::operator*(Matrix mat) {
-  mat *= *this;
-  return mat;
-}
+template <typename E>
+Matrix<T>& Matrix<T>::operator=(const MatrixExpression<E>& expr) {
+  const E& exprRes = expr.getDerived();
+
+  // An expression can only refer to this matrix if their sizes match; otherwise it is evaluated in a new one
+  if (width != exprRes.getWidth() || height != exprRes.getHeight() || stride != exprRes.getStride()) {
+    *this = Matrix(expr);
+    return *this;
+  }
 
-template <typename T>
-Matrix<T> Matrix<T>::operator*(float val) {
-  Matrix<T> res = *this;
-  res *= val;
-  return res;
+  channelCount = exprRes.getChannelCount();
+  imgBitDepth = exprRes.getImgBitDepth();
+  colorspace = exprRes.getColorspace();
+
+  // Each element only depends on the ones at the same index, which can then be overwritten right away
+  for (std::size_t heightIndex = 0; heightIndex < height; ++heightIndex) {
+    for (std::size_t eltIndex = heightIndex * stride; eltIndex < heightIndex * stride + width * channelCount; ++eltIndex)
+      data[eltIndex] = static_cast<T>(exprRes[eltIndex]);
+  }
+
+  return *this;
 }
 
 template <typename T>
-Matrix<T> Matrix<T>::operator/(Matrix mat) {
-  mat /= *this;
-  return mat;
+template <ElementwiseOperation Op>
+Matrix<T>& Matrix<T>::applyElementwise(const Matrix& mat) {
+  assert(("Error: Matrices aren't the same size", width == mat.getWidth()
+                                                  && height == mat.getHeight()
+                                                  && channelCount == mat.getChannelCount()));
+
+  // Contiguous matrices are processed at once, their rows following each other without any gap
+  if (!paddedRows && !mat.hasPaddedRows()) {
+    Simd::applyElementwise<Op>(data.data(), mat.getData().data(), data.size());
+    return *this;
+  }
+
+  for (std::size_t heightIndex = 0; heightIndex < height; ++heightIndex)
+    Simd::applyElementwise<Op>(data.data() + heightIndex * stride, mat.getData().data() + heightIndex * mat.getStride(), width * channelCount);
+  return *this;
 }
 
 template <typename T>
-Matrix<T> Matrix<T>::operator/(float val) {
-  Matrix<T> res = *this;
-  res /= val;
-  return res;
+template <ElementwiseOperation Op>
+Matrix<T>& Matrix<T>::applyElementwise(float val) {
+  if (!paddedRows) {
+    Simd::applyElementwise<Op>(data.data(), val, data.size());
+    return *this;
+  }
+
+  for (std::size_t heightIndex = 0; heightIndex < height; ++heightIndex)
+    Simd::applyElementwise<Op>(data.data() + heightIndex * stride, val, width * channelCount);
+  return *this;
 }
 
 template <typename T>
 Matrix<T>& Matrix<T>::operator+=(const Matrix& mat) {
-  assert(("Error: Matrices aren't the same size", data.size() == mat.getData().size()));
-
-  for (std::size_t i = 0; i < data.size(); ++i)
-    data[i] += mat.getData()[i];
-  return *this;
+  return applyElementwise<ARCV_ELEMENTWISE_ADD>(mat);
 }
 
 template <typename T>
 Matrix<T>& Matrix<T>::operator+=(float val) {
-  for (T& it : data)
-    it += val;
-  return *this;
+  return applyElementwise<ARCV_ELEMENTWISE_ADD>(val);
 }
 
 template <typename T>
 Matrix<T>& Matrix<T>::operator-=(const Matrix& mat) {
-  assert(("Error: Matrices aren't the same size", data.size() == mat.getData().size()));
-
-  for (std::size_t i = 0; i < data.size(); ++i)
-    data[i] -= mat.getData()[i];
-  return *this;
+  return applyElementwise<ARCV_ELEMENTWISE_SUB>(mat);
 }
 
 template <typename T>
 Matrix<T>& Matrix<T>::operator-=(float val) {
-  for (T& it : data)
-    it -= val;
-  return *this;
+  return applyElementwise<ARCV_ELEMENTWISE_SUB>(val);
 }
 
 template <typename T>
 Matrix<T>& Matrix<T>::operator*=(const Matrix& mat) {
-  assert(("Error: Matrices aren't the same size", data.size() == mat.getData().size()));
-
-  for (std::size_t i = 0; i < data.size(); ++i)
-    data[i] *= mat.getData()[i];
-  return *this;
+  return applyElementwise<ARCV_ELEMENTWISE_MUL>(mat);
 }
 
 template <typename T>
 Matrix<T>& Matrix<T>::operator*=(float val) {
-  for (T& it : data)
-    it *= val;
-  return *this;
+  return applyElementwise<ARCV_ELEMENTWISE_MUL>(val);
 }
 
 template <typename T>
 Matrix<T>& Matrix<T>::operator/=(const Matrix& mat) {
-  assert(("Error: Matrices aren't the same size", data.size() == mat.getData().size()));
-
-  for (std::size_t i = 0; i < data.size(); ++i)
-    data[i] /= mat.getData()[i];
-  return *this;
+  return applyElementwise<ARCV_ELEMENTWISE_DIV>(mat);
 }
 
 template <typename T>
 Matrix<T>& Matrix<T>::operator/=(float val) {
-  for (T& it : data)
-    it /= val;
-  return *this;
+  return applyElementwise<ARCV_ELEMENTWISE_DIV>(val);
 }
 
 } // namespace Arcv
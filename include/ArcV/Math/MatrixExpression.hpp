@@ -0,0 +1,89 @@
+#pragma once
+
+#ifndef ARCV_MATRIXEXPRESSION_HPP
+#define ARCV_MATRIXEXPRESSION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <functional>
+#include <type_traits>
+
+namespace Arcv {
+
+template <typename T> class Matrix;
+
+// Base of every lazily evaluated elementwise operation; a whole chain is computed in a single pass once
+//  assigned to a Matrix, without creating any temporary one
+template <typename Derived>
+class MatrixExpression {
+public:
+  const Derived& getDerived() const { return static_cast<const Derived&>(*this); }
+};
+
+// Holds a scalar operand, seen as a matrix filled with the same value everywhere
+class MatrixScalar {
+public:
+  using ValueType = float;
+
+  MatrixScalar(float value) : value{ value } {}
+
+  float operator[](std::size_t) const { return value; }
+
+private:
+  float value;
+};
+
+// Matrices are referenced, whereas nested expressions (holding references themselves) are copied
+template <typename E> struct ExpressionOperand { using Type = const E; };
+template <typename T> struct ExpressionOperand<Matrix<T>> { using Type = const Matrix<T>&; };
+
+template <typename Op, typename L, typename R>
+class MatrixBinaryExpression : public MatrixExpression<MatrixBinaryExpression<Op, L, R>> {
+public:
+  using ValueType = decltype(std::declval<Op>()(std::declval<typename L::ValueType>(), std::declval<typename R::ValueType>()));
+
+  MatrixBinaryExpression(const L& lhs, const R& rhs) : lhs{ lhs }, rhs{ rhs } {}
+
+  std::size_t getWidth() const { return getShape().getWidth(); }
+  std::size_t getHeight() const { return getShape().getHeight(); }
+  std::size_t getStride() const { return getShape().getStride(); }
+  uint8_t getImgBitDepth() const { return getShape().getImgBitDepth(); }
+  uint8_t getChannelCount() const { return getShape().getChannelCount(); }
+  auto getColorspace() const { return getShape().getColorspace(); }
+  bool hasPaddedRows() const { return getShape().hasPaddedRows(); }
+
+  ValueType operator[](std::size_t index) const { return Op()(lhs[index], rhs[index]); }
+
+private:
+  // The result takes the dimensions of the first operand which is not a scalar
+  const auto& getShape() const { return selectShape(lhs, rhs, std::is_same<L, MatrixScalar>()); }
+  template <typename A, typename B> static const A& selectShape(const A& lhs, const B&, std::false_type) { return lhs; }
+  template <typename A, typename B> static const B& selectShape(const A&, const B& rhs, std::true_type) { return rhs; }
+
+  typename ExpressionOperand<L>::Type lhs;
+  typename ExpressionOperand<R>::Type rhs;
+};
+
+template <typename L, typename R>
+MatrixBinaryExpression<std::plus<>, L, R> operator+(const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs);
+template <typename L> MatrixBinaryExpression<std::plus<>, L, MatrixScalar> operator+(const MatrixExpression<L>& lhs, float rhs);
+template <typename R> MatrixBinaryExpression<std::plus<>, MatrixScalar, R> operator+(float lhs, const MatrixExpression<R>& rhs);
+template <typename L, typename R>
+MatrixBinaryExpression<std::minus<>, L, R> operator-(const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs);
+template <typename L> MatrixBinaryExpression<std::minus<>, L, MatrixScalar> operator-(const MatrixExpression<L>& lhs, float rhs);
+template <typename R> MatrixBinaryExpression<std::minus<>, MatrixScalar, R> operator-(float lhs, const MatrixExpression<R>& rhs);
+template <typename L, typename R>
+MatrixBinaryExpression<std::multiplies<>, L, R> operator*(const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs);
+template <typename L> MatrixBinaryExpression<std::multiplies<>, L, MatrixScalar> operator*(const MatrixExpression<L>& lhs, float rhs);
+template <typename R> MatrixBinaryExpression<std::multiplies<>, MatrixScalar, R> operator*(float lhs, const MatrixExpression<R>& rhs);
+template <typename L, typename R>
+MatrixBinaryExpression<std::divides<>, L, R> operator/(const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs);
+template <typename L> MatrixBinaryExpression<std::divides<>, L, MatrixScalar> operator/(const MatrixExpression<L>& lhs, float rhs);
+template <typename R> MatrixBinaryExpression<std::divides<>, MatrixScalar, R> operator/(float lhs, const MatrixExpression<R>& rhs);
+
+} // namespace Arcv
+
+#include "ArcV/Math/MatrixExpression.inl"
+
+#endif // ARCV_MATRIXEXPRESSION_HPP
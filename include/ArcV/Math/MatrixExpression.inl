@@ -0,0 +1,81 @@
+#include <cassert>
+
+namespace Arcv {
+
+template <typename L, typename R>
+MatrixBinaryExpression<std::plus<>, L, R> operator+(const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs) {
+  assert(("Error: Matrices aren't the same size", lhs.getDerived().getWidth() == rhs.getDerived().getWidth()
+                                                  && lhs.getDerived().getHeight() == rhs.getDerived().getHeight()
+                                                  && lhs.getDerived().getStride() == rhs.getDerived().getStride()));
+
+  return MatrixBinaryExpression<std::plus<>, L, R>(lhs.getDerived(), rhs.getDerived());
+}
+
+template <typename L>
+MatrixBinaryExpression<std::plus<>, L, MatrixScalar> operator+(const MatrixExpression<L>& lhs, float rhs) {
+  return MatrixBinaryExpression<std::plus<>, L, MatrixScalar>(lhs.getDerived(), rhs);
+}
+
+template <typename R>
+MatrixBinaryExpression<std::plus<>, MatrixScalar, R> operator+(float lhs, const MatrixExpression<R>& rhs) {
+  return MatrixBinaryExpression<std::plus<>, MatrixScalar, R>(lhs, rhs.getDerived());
+}
+
+template <typename L, typename R>
+MatrixBinaryExpression<std::minus<>, L, R> operator-(const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs) {
+  assert(("Error: Matrices aren't the same size", lhs.getDerived().getWidth() == rhs.getDerived().getWidth()
+                                                  && lhs.getDerived().getHeight() == rhs.getDerived().getHeight()
+                                                  && lhs.getDerived().getStride() == rhs.getDerived().getStride()));
+
+  return MatrixBinaryExpression<std::minus<>, L, R>(lhs.getDerived(), rhs.getDerived());
+}
+
+template <typename L>
+MatrixBinaryExpression<std::minus<>, L, MatrixScalar> operator-(const MatrixExpression<L>& lhs, float rhs) {
+  return MatrixBinaryExpression<std::minus<>, L, MatrixScalar>(lhs.getDerived(), rhs);
+}
+
+template <typename R>
+MatrixBinaryExpression<std::minus<>, MatrixScalar, R> operator-(float lhs, const MatrixExpression<R>& rhs) {
+  return MatrixBinaryExpression<std::minus<>, MatrixScalar, R>(lhs, rhs.getDerived());
+}
+
+template <typename L, typename R>
+MatrixBinaryExpression<std::multiplies<>, L, R> operator*(const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs) {
+  assert(("Error: Matrices aren't the same size", lhs.getDerived().getWidth() == rhs.getDerived().getWidth()
+                                                  && lhs.getDerived().getHeight() == rhs.getDerived().getHeight()
+                                                  && lhs.getDerived().getStride() == rhs.getDerived().getStride()));
+
+  return MatrixBinaryExpression<std::multiplies<>, L, R>(lhs.getDerived(), rhs.getDerived());
+}
+
+template <typename L>
+MatrixBinaryExpression<std::multiplies<>, L, MatrixScalar> operator*(const MatrixExpression<L>& lhs, float rhs) {
+  return MatrixBinaryExpression<std::multiplies<>, L, MatrixScalar>(lhs.getDerived(), rhs);
+}
+
+template <typename R>
+MatrixBinaryExpression<std::multiplies<>, MatrixScalar, R> operator*(float lhs, const MatrixExpression<R>& rhs) {
+  return MatrixBinaryExpression<std::multiplies<>, MatrixScalar, R>(lhs, rhs.getDerived());
+}
+
+template <typename L, typename R>
+MatrixBinaryExpression<std::divides<>, L, R> operator/(const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs) {
+  assert(("Error: Matrices aren't the same size", lhs.getDerived().getWidth() == rhs.getDerived().getWidth()
+                                                  && lhs.getDerived().getHeight() == rhs.getDerived().getHeight()
+                                                  && lhs.getDerived().getStride() == rhs.getDerived().getStride()));
+
+  return MatrixBinaryExpression<std::divides<>, L, R>(lhs.getDerived(), rhs.getDerived());
+}
+
+template <typename L>
+MatrixBinaryExpression<std::divides<>, L, MatrixScalar> operator/(const MatrixExpression<L>& lhs, float rhs) {
+  return MatrixBinaryExpression<std::divides<>, L, MatrixScalar>(lhs.getDerived(), rhs);
+}
+
+template <typename R>
+MatrixBinaryExpression<std::divides<>, MatrixScalar, R> operator/(float lhs, const MatrixExpression<R>& rhs) {
+  return MatrixBinaryExpression<std::divides<>, MatrixScalar, R>(lhs, rhs.getDerived());
+}
+
+} // namespace Arcv
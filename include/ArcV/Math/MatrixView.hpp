@@ -0,0 +1,69 @@
+#pragma once
+
+#ifndef ARCV_MATRIXVIEW_HPP
+#define ARCV_MATRIXVIEW_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+#include "ArcV/Math/Matrix.hpp"
+
+namespace Arcv {
+
+// Non-owning window over pixels laid out row by row; rows are rowStride elements apart (can be negative)
+template <typename T = float>
+class MatrixView {
+public:
+  using ValueType = std::remove_const_t<T>;
+
+  MatrixView() = default;
+
+  MatrixView(T* data,
+             std::size_t width,
+             std::size_t height,
+             uint8_t channels,
+             std::ptrdiff_t rowStride,
+             uint8_t bitDepth = 8,
+             Colorspace colorspace = ARCV_COLORSPACE_GRAY)
+    : data{ data },
+      width{ width },
+      height{ height },
+      rowStride{ rowStride },
+      channelCount{ channels },
+      imgBitDepth{ bitDepth },
+      colorspace{ colorspace } {}
+
+  MatrixView(const Matrix<ValueType>& mat);
+  MatrixView(Matrix<ValueType>& mat);
+  template <typename TI, typename = std::enable_if_t<std::is_convertible<TI*, T*>::value>>
+  MatrixView(const MatrixView<TI>& view);
+
+  T* getData() const { return data; }
+  std::size_t getWidth() const { return width; }
+  std::size_t getHeight() const { return height; }
+  std::ptrdiff_t getRowStride() const { return rowStride; }
+  uint8_t getChannelCount() const { return channelCount; }
+  uint8_t getImgBitDepth() const { return imgBitDepth; }
+  Colorspace getColorspace() const { return colorspace; }
+  std::size_t getRowLength() const { return width * channelCount; }
+  bool isContiguous() const { return rowStride == static_cast<std::ptrdiff_t>(getRowLength()); }
+
+  T* getRow(std::size_t heightIndex) const { return data + static_cast<std::ptrdiff_t>(heightIndex) * rowStride; }
+  MatrixView subView(std::size_t widthBegin, std::size_t widthEnd, std::size_t heightBegin, std::size_t heightEnd) const;
+  T& operator()(std::size_t widthIndex, std::size_t heightIndex, uint8_t chan = 0) const {
+    return getRow(heightIndex)[widthIndex * channelCount + chan];
+  }
+
+private:
+  T* data = nullptr;
+  std::size_t width = 0, height = 0;
+  std::ptrdiff_t rowStride = 0;
+  uint8_t channelCount = 1, imgBitDepth = 8;
+  Colorspace colorspace = ARCV_COLORSPACE_GRAY;
+};
+
+} // namespace Arcv
+
+#include "ArcV/Math/MatrixView.inl"
+
+#endif // ARCV_MATRIXVIEW_HPP
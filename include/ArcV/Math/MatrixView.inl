@@ -0,0 +1,48 @@
+#include <cassert>
+
+namespace Arcv {
+
+template <typename T>
+MatrixView<T>::MatrixView(const Matrix<ValueType>& mat) : MatrixView(mat.getData().data(),
+                                                                   mat.getWidth(),
+                                                                   mat.getHeight(),
+                                                                   mat.getChannelCount(),
+                                                                   static_cast<std::ptrdiff_t>(mat.getStride()),
+                                                                   mat.getImgBitDepth(),
+                                                                   mat.getColorspace()) {}
+
+template <typename T>
+MatrixView<T>::MatrixView(Matrix<ValueType>& mat) : MatrixView(mat.getData().data(),
+                                                             mat.getWidth(),
+                                                             mat.getHeight(),
+                                                             mat.getChannelCount(),
+                                                             static_cast<std::ptrdiff_t>(mat.getStride()),
+                                                             mat.getImgBitDepth(),
+                                                             mat.getColorspace()) {}
+
+template <typename T>
+template <typename TI, typename>
+MatrixView<T>::MatrixView(const MatrixView<TI>& view) : MatrixView(view.getData(),
+                                                                  view.getWidth(),
+                                                                  view.getHeight(),
+                                                                  view.getChannelCount(),
+                                                                  view.getRowStride(),
+                                                                  view.getImgBitDepth(),
+                                                                  view.getColorspace()) {}
+
+template <typename T>
+MatrixView<T> MatrixView<T>::subView(std::size_t widthBegin, std::size_t widthEnd,
+                                     std::size_t heightBegin, std::size_t heightEnd) const {
+  assert(("Error: Beginning boundaries must be lower than ending ones", widthBegin < widthEnd && heightBegin < heightEnd));
+  assert(("Error: Sub-view must lie within the view", widthEnd <= width && heightEnd <= height));
+
+  return MatrixView(getRow(heightBegin) + widthBegin * channelCount,
+                    widthEnd - widthBegin,
+                    heightEnd - heightBegin,
+                    channelCount,
+                    rowStride,
+                    imgBitDepth,
+                    colorspace);
+}
+
+} // namespace Arcv
@@ -0,0 +1,62 @@
+#pragma once
+
+#ifndef ARCV_MEMORYARENA_HPP
+#define ARCV_MEMORYARENA_HPP
+
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace Arcv {
+
+// Linear allocator handing out memory from large chunks; nothing is freed individually, everything being
+//  released at once by reset(), typically at the end of each frame
+class MemoryArena {
+public:
+  explicit MemoryArena(std::size_t chunkSize = 1 << 24) : chunkSize{ chunkSize } {}
+  MemoryArena(const MemoryArena&) = delete;
+  MemoryArena& operator=(const MemoryArena&) = delete;
+
+  std::size_t getUsedMemory() const { return usedMemory; }
+  std::size_t getReservedMemory() const { return reservedMemory; }
+  // Arena in which temporaries are allocated on the current thread, or nullptr if they are to go on the heap
+  static MemoryArena* getCurrent() { return currentArena; }
+
+  void* allocate(std::size_t byteCount, std::size_t alignment);
+  void reset();
+
+private:
+  friend class MemoryArenaScope;
+
+  struct Chunk {
+    std::unique_ptr<uint8_t[]> memory;
+    std::size_t size;
+  };
+
+  static thread_local MemoryArena* currentArena;
+
+  std::size_t chunkSize;
+  std::vector<Chunk> chunks;
+  std::size_t chunkIndex = 0;
+  std::size_t chunkOffset = 0;
+  std::size_t usedMemory = 0;
+  std::size_t reservedMemory = 0;
+};
+
+// Makes an arena the current one for the lifetime of the scope, restoring the previous one afterwards
+class MemoryArenaScope {
+public:
+  explicit MemoryArenaScope(MemoryArena& arena) : prevArena{ MemoryArena::currentArena } { MemoryArena::currentArena = &arena; }
+  MemoryArenaScope(const MemoryArenaScope&) = delete;
+  MemoryArenaScope& operator=(const MemoryArenaScope&) = delete;
+
+  ~MemoryArenaScope() { MemoryArena::currentArena = prevArena; }
+
+private:
+  MemoryArena* prevArena;
+};
+
+} // namespace Arcv
+
+#endif // ARCV_MEMORYARENA_HPP
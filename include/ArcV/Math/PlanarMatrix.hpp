@@ -0,0 +1,88 @@
+#pragma once
+
+#ifndef ARCV_PLANARMATRIX_HPP
+#define ARCV_PLANARMATRIX_HPP
+
+#include <vector>
+#include <cstdint>
+
+#include "ArcV/Math/Matrix.hpp"
+#include "ArcV/Math/MatrixView.hpp"
+
+namespace Arcv {
+
+// Pixels stored one plane per channel instead of interleaved, each plane being made of height rows of stride elements;
+//  per-channel operations can then work on contiguous rows rather than on every channelCount-th element
+template <typename T = float>
+class PlanarMatrix {
+public:
+  using ValueType = T;
+
+  PlanarMatrix() = default;
+  explicit PlanarMatrix(const AlignedAllocator<T>& allocator) : data(allocator) {}
+
+  PlanarMatrix(std::size_t width,
+               std::size_t height,
+               uint8_t channels,
+               uint8_t bitDepth,
+               Colorspace colorspace,
+               bool padRows = false)
+    : width{ width },
+      height{ height },
+      channelCount{ channels },
+      imgBitDepth{ bitDepth },
+      colorspace{ colorspace },
+      paddedRows{ padRows },
+      stride{ Matrix<T>::computeStride(width, 1, padRows) },
+      data(stride * height * channels) {}
+
+  explicit PlanarMatrix(const MatrixView<const T>& view) { copyFrom(view); }
+
+  std::size_t getWidth() const { return width; }
+  std::size_t getHeight() const { return height; }
+  uint8_t getImgBitDepth() const { return imgBitDepth; }
+  uint8_t getChannelCount() const { return channelCount; }
+  Colorspace getColorspace() const { return colorspace; }
+  std::size_t getStride() const { return stride; }
+  bool hasPaddedRows() const { return paddedRows; }
+  AlignedAllocator<T> getAllocator() const { return data.get_allocator(); }
+  const std::vector<T, AlignedAllocator<T>>& getData() const { return data; }
+  std::vector<T, AlignedAllocator<T>>& getData() { return data; }
+  // Single-channel view on a plane, whose colorspace is left to gray
+  MatrixView<const T> getPlane(uint8_t chan) const;
+  MatrixView<T> getPlane(uint8_t chan);
+
+  // Reuses the already allocated memory whenever it is large enough; elements' values are then unspecified
+  void reshape(std::size_t width, std::size_t height, uint8_t channels, uint8_t bitDepth, Colorspace colorspace, bool padRows);
+  // Splits the view's interleaved pixels into planes
+  void copyFrom(const MatrixView<const T>& view);
+  // Merges planes back into interleaved pixels
+  Matrix<T> toInterleaved() const;
+  void toInterleaved(Matrix<T>& res) const;
+
+private:
+  std::size_t width = 0, height = 0;
+  uint8_t channelCount = 1, imgBitDepth = 8;
+  Colorspace colorspace = ARCV_COLORSPACE_GRAY;
+  bool paddedRows = false;
+  std::size_t stride = 0;                       // Amount of elements between two rows' beginnings within a plane
+  std::vector<T, AlignedAllocator<T>> data;
+};
+
+// Convolves each plane separately, with the same fixed point rules & border types as interleaved pixels
+template <typename T> PlanarMatrix<T> convolve(const PlanarMatrix<T>& mat, const Matrix<float>& convMat,
+                                               BorderType border = ARCV_BORDER_TYPE_CONSTANT, float borderValue = 0.f);
+template <typename TI, typename TO> void convolve(const PlanarMatrix<TI>& mat, const Matrix<float>& convMat, PlanarMatrix<TO>& res,
+                                                  BorderType border = ARCV_BORDER_TYPE_CONSTANT, float borderValue = 0.f);
+template <typename T> PlanarMatrix<T> convolveSeparable(const PlanarMatrix<T>& mat, const Matrix<float>& rowKernel,
+                                                        const Matrix<float>& columnKernel, BorderType border = ARCV_BORDER_TYPE_CONSTANT,
+                                                        float borderValue = 0.f);
+template <typename TI, typename TO> void convolveSeparable(const PlanarMatrix<TI>& mat, const Matrix<float>& rowKernel,
+                                                           const Matrix<float>& columnKernel, PlanarMatrix<TO>& res,
+                                                           BorderType border = ARCV_BORDER_TYPE_CONSTANT, float borderValue = 0.f);
+
+} // namespace Arcv
+
+#include "ArcV/Math/PlanarMatrix.inl"
+
+#endif // ARCV_PLANARMATRIX_HPP
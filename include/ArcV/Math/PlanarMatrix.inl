@@ -0,0 +1,69 @@
+#include <cassert>
+
+namespace Arcv {
+
+template <typename T>
+MatrixView<const T> PlanarMatrix<T>::getPlane(uint8_t chan) const {
+  assert(("Error: Plane index must be lower than the channel count", chan < channelCount));
+
+  return MatrixView<const T>(data.data() + chan * height * stride, width, height, 1, static_cast<std::ptrdiff_t>(stride), imgBitDepth);
+}
+
+template <typename T>
+MatrixView<T> PlanarMatrix<T>::getPlane(uint8_t chan) {
+  assert(("Error: Plane index must be lower than the channel count", chan < channelCount));
+
+  return MatrixView<T>(data.data() + chan * height * stride, width, height, 1, static_cast<std::ptrdiff_t>(stride), imgBitDepth);
+}
+
+template <typename T>
+void PlanarMatrix<T>::reshape(std::size_t width, std::size_t height, uint8_t channels, uint8_t bitDepth,
+                              Colorspace colorspace, bool padRows) {
+  this->width = width;
+  this->height = height;
+  this->channelCount = channels;
+  this->imgBitDepth = bitDepth;
+  this->colorspace = colorspace;
+  this->paddedRows = padRows;
+  this->stride = Matrix<T>::computeStride(width, 1, padRows);
+
+  data.resize(stride * height * channels);
+}
+
+template <typename T>
+void PlanarMatrix<T>::copyFrom(const MatrixView<const T>& view) {
+  reshape(view.getWidth(), view.getHeight(), view.getChannelCount(), view.getImgBitDepth(), view.getColorspace(), paddedRows);
+
+  std::vector<T*> planeRows(channelCount);
+
+  for (std::size_t heightIndex = 0; heightIndex < height; ++heightIndex) {
+    for (uint8_t chan = 0; chan < channelCount; ++chan)
+      planeRows[chan] = data.data() + (chan * height + heightIndex) * stride;
+
+    Simd::deinterleave(view.getRow(heightIndex), width, channelCount, planeRows.data());
+  }
+}
+
+template <typename T>
+Matrix<T> PlanarMatrix<T>::toInterleaved() const {
+  Matrix<T> res(width, height, channelCount, imgBitDepth, colorspace, paddedRows);
+  toInterleaved(res);
+
+  return res;
+}
+
+template <typename T>
+void PlanarMatrix<T>::toInterleaved(Matrix<T>& res) const {
+  res.reshape(width, height, channelCount, imgBitDepth, colorspace, res.hasPaddedRows());
+
+  std::vector<const T*> planeRows(channelCount);
+
+  for (std::size_t heightIndex = 0; heightIndex < height; ++heightIndex) {
+    for (uint8_t chan = 0; chan < channelCount; ++chan)
+      planeRows[chan] = data.data() + (chan * height + heightIndex) * stride;
+
+    Simd::interleave(planeRows.data(), width, channelCount, res.getData().data() + heightIndex * res.getStride());
+  }
+}
+
+} // namespace Arcv
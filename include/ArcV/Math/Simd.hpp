@@ -0,0 +1,161 @@
+#pragma once
+
+#ifndef ARCV_SIMD_HPP
+#define ARCV_SIMD_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+enum SimdInstructionSet { ARCV_SIMD_NONE = 0,
+                          ARCV_SIMD_SSE2,
+                          ARCV_SIMD_AVX2,
+                          ARCV_SIMD_AVX512 };
+
+enum ElementwiseOperation { ARCV_ELEMENTWISE_ADD = 0,
+                            ARCV_ELEMENTWISE_SUB,
+                            ARCV_ELEMENTWISE_MUL,
+                            ARCV_ELEMENTWISE_DIV };
+
+namespace Arcv {
+
+namespace Simd {
+
+// Most recent instruction set supported by the CPU, detected once at startup
+SimdInstructionSet getInstructionSet();
+// Restricts kernels to an older instruction set than the detected one (for testing or benchmarking)
+void setInstructionSet(SimdInstructionSet instructionSet);
+
+// Computes lhs[i] = lhs[i] op rhs[i] (or op val) on count elements; results are saturated for uint8_t
+template <ElementwiseOperation Op, typename T> void applyElementwise(T* lhs, const T* rhs, std::size_t count);
+template <ElementwiseOperation Op, typename T> void applyElementwise(T* lhs, float val, std::size_t count);
+
+// Scalar implementations, used for types without vectorized kernels & as reference for the others
+template <ElementwiseOperation Op, typename T> void applyElementwiseReference(T* lhs, const T* rhs, std::size_t count);
+template <ElementwiseOperation Op, typename T> void applyElementwiseReference(T* lhs, float val, std::size_t count);
+
+// Accumulates, for each channel of pixelCount interleaved pixels, bounds into mins & maxs and the sums of
+//  (value - shift) & (value - shift)^2 into sums & squaredSums; shifting by a value close to the mean keeps the
+//  variance deduced from them accurate
+template <typename T>
+void accumulateStatistics(const T* pixels, std::size_t pixelCount, uint8_t channelCount, const double* shifts,
+                          T* mins, T* maxs, double* sums, double* squaredSums);
+template <typename T>
+void accumulateStatisticsReference(const T* pixels, std::size_t pixelCount, uint8_t channelCount, const double* shifts,
+                                   T* mins, T* maxs, double* sums, double* squaredSums);
+
+// Computes output[i] = input[i] * scale + offset on count elements, saturating the results to the output type
+template <typename TI, typename TO> void convert(const TI* input, TO* output, std::size_t count, float scale = 1.f, float offset = 0.f);
+template <typename TI, typename TO> void convertReference(const TI* input, TO* output, std::size_t count, float scale, float offset);
+
+// Splits pixelCount interleaved pixels into one plane per channel, or merges such planes back into interleaved pixels
+template <typename T> void deinterleave(const T* pixels, std::size_t pixelCount, uint8_t channelCount, T* const* planes);
+template <typename T> void interleave(const T* const* planes, std::size_t pixelCount, uint8_t channelCount, T* pixels);
+template <typename T> void deinterleaveReference(const T* pixels, std::size_t pixelCount, uint8_t channelCount, T* const* planes);
+template <typename T> void interleaveReference(const T* const* planes, std::size_t pixelCount, uint8_t channelCount, T* pixels);
+
+// Computes sums[i] = weights[0] * input[offsets[0] + i] + ... + weights[weightCount - 1] * input[offsets[weightCount - 1] + i]
+//  on count elements, the products being added in that order; this is a convolution's inner loop, each weight applying
+//  to a row shifted by the corresponding tap's position
+template <typename TI, typename TA>
+void computeWeightedSums(const TI* input, TA* sums, std::size_t count, const std::ptrdiff_t* offsets, const TA* weights,
+                         std::size_t weightCount);
+template <typename TI, typename TA>
+void computeWeightedSumsReference(const TI* input, TA* sums, std::size_t count, const std::ptrdiff_t* offsets, const TA* weights,
+                                  std::size_t weightCount);
+
+// Applies a radix-2 FFT stage to batchSize sequences of sequenceSize complex values, stored as (real, imaginary) pairs of
+//  floats, the n-th values of all sequences lying contiguously rowStride values after the (n - 1)-th ones: within each
+//  span of 2 * halfLength values, v[j] & v[j + halfLength] become v[j] + w[j] * v[j + halfLength] & v[j] - w[j] * v[j + halfLength],
+//  w holding halfLength twiddles; batches are processed across their sequences, adjacent ones filling vectors
+void computeFftStage(float* data, std::size_t sequenceSize, std::size_t rowStride, std::size_t batchSize, std::size_t halfLength,
+                     const float* twiddles);
+void computeFftStageReference(float* data, std::size_t sequenceSize, std::size_t rowStride, std::size_t batchSize,
+                              std::size_t halfLength, const float* twiddles);
+
+// Computes a row of a third order recursive filter, results[i] = coefficients[0] * inputs[i] + coefficients[1] * previousRows[0][i]
+//  + coefficients[2] * previousRows[1][i] + coefficients[3] * previousRows[2][i], summed in that order; results may be inputs
+void computeRecursiveFilterRow(const float* inputs, const float* const* previousRows, float* results, std::size_t count,
+                               const float* coefficients);
+void computeRecursiveFilterRowReference(const float* inputs, const float* const* previousRows, float* results, std::size_t count,
+                                        const float* coefficients);
+
+// Selection network leaving the median of its values in the middle one: each of its pairs (a, b) puts the smaller of
+//  both values in a & the larger one in b, as done by the minimum & maximum of vectors
+struct MedianNetwork {
+  const uint8_t (*pairs)[2];
+  std::size_t pairCount;
+};
+
+// Networks exist for 9 & 25 values, the 3x3 & 5x5 neighbourhoods of median filters
+MedianNetwork getMedianNetwork(std::size_t valueCount);
+
+// Gives medians[i] = the median of inputs[0][i], ..., inputs[inputCount - 1][i] on count elements, inputCount being 9 or
+//  25; the inputs of adjacent elements go together through the median network. Medians must not be any of the inputs
+template <typename T> void computeMedians(const T* const* inputs, T* medians, std::size_t count, std::size_t inputCount);
+template <typename T> void computeMediansReference(const T* const* inputs, T* medians, std::size_t count, std::size_t inputCount);
+
+// Computes res[i] = min(lhs[i], rhs[i]) (or max) on count elements, the steps of morphological filters' passes; res may
+//  be lhs or rhs
+template <typename T> void computeMinimums(const T* lhs, const T* rhs, T* res, std::size_t count);
+template <typename T> void computeMaximums(const T* lhs, const T* rhs, T* res, std::size_t count);
+template <typename T> void computeMinimumsReference(const T* lhs, const T* rhs, T* res, std::size_t count);
+template <typename T> void computeMaximumsReference(const T* lhs, const T* rhs, T* res, std::size_t count);
+
+template <> void applyElementwise<ARCV_ELEMENTWISE_ADD>(float* lhs, const float* rhs, std::size_t count);
+template <> void applyElementwise<ARCV_ELEMENTWISE_SUB>(float* lhs, const float* rhs, std::size_t count);
+template <> void applyElementwise<ARCV_ELEMENTWISE_MUL>(float* lhs, const float* rhs, std::size_t count);
+template <> void applyElementwise<ARCV_ELEMENTWISE_DIV>(float* lhs, const float* rhs, std::size_t count);
+template <> void applyElementwise<ARCV_ELEMENTWISE_ADD>(float* lhs, float val, std::size_t count);
+template <> void applyElementwise<ARCV_ELEMENTWISE_SUB>(float* lhs, float val, std::size_t count);
+template <> void applyElementwise<ARCV_ELEMENTWISE_MUL>(float* lhs, float val, std::size_t count);
+template <> void applyElementwise<ARCV_ELEMENTWISE_DIV>(float* lhs, float val, std::size_t count);
+template <> void applyElementwise<ARCV_ELEMENTWISE_ADD>(uint8_t* lhs, const uint8_t* rhs, std::size_t count);
+template <> void applyElementwise<ARCV_ELEMENTWISE_SUB>(uint8_t* lhs, const uint8_t* rhs, std::size_t count);
+template <> void applyElementwise<ARCV_ELEMENTWISE_MUL>(uint8_t* lhs, const uint8_t* rhs, std::size_t count);
+template <> void applyElementwise<ARCV_ELEMENTWISE_DIV>(uint8_t* lhs, const uint8_t* rhs, std::size_t count);
+template <> void applyElementwise<ARCV_ELEMENTWISE_ADD>(uint8_t* lhs, float val, std::size_t count);
+template <> void applyElementwise<ARCV_ELEMENTWISE_SUB>(uint8_t* lhs, float val, std::size_t count);
+template <> void applyElementwise<ARCV_ELEMENTWISE_MUL>(uint8_t* lhs, float val, std::size_t count);
+template <> void applyElementwise<ARCV_ELEMENTWISE_DIV>(uint8_t* lhs, float val, std::size_t count);
+template <> void accumulateStatistics(const float* pixels, std::size_t pixelCount, uint8_t channelCount, const double* shifts,
+                                      float* mins, float* maxs, double* sums, double* squaredSums);
+template <> void convert(const uint8_t* input, uint8_t* output, std::size_t count, float scale, float offset);
+template <> void convert(const uint8_t* input, int16_t* output, std::size_t count, float scale, float offset);
+template <> void convert(const uint8_t* input, float* output, std::size_t count, float scale, float offset);
+template <> void convert(const int16_t* input, uint8_t* output, std::size_t count, float scale, float offset);
+template <> void convert(const int16_t* input, int16_t* output, std::size_t count, float scale, float offset);
+template <> void convert(const int16_t* input, float* output, std::size_t count, float scale, float offset);
+template <> void convert(const float* input, uint8_t* output, std::size_t count, float scale, float offset);
+template <> void convert(const float* input, int16_t* output, std::size_t count, float scale, float offset);
+template <> void convert(const float* input, float* output, std::size_t count, float scale, float offset);
+template <> void deinterleave(const uint8_t* pixels, std::size_t pixelCount, uint8_t channelCount, uint8_t* const* planes);
+template <> void deinterleave(const int16_t* pixels, std::size_t pixelCount, uint8_t channelCount, int16_t* const* planes);
+template <> void deinterleave(const float* pixels, std::size_t pixelCount, uint8_t channelCount, float* const* planes);
+template <> void interleave(const uint8_t* const* planes, std::size_t pixelCount, uint8_t channelCount, uint8_t* pixels);
+template <> void interleave(const int16_t* const* planes, std::size_t pixelCount, uint8_t channelCount, int16_t* pixels);
+template <> void interleave(const float* const* planes, std::size_t pixelCount, uint8_t channelCount, float* pixels);
+template <> void computeWeightedSums(const float* input, float* sums, std::size_t count, const std::ptrdiff_t* offsets,
+                                     const float* weights, std::size_t weightCount);
+template <> void computeWeightedSums(const uint8_t* input, int32_t* sums, std::size_t count, const std::ptrdiff_t* offsets,
+                                     const int32_t* weights, std::size_t weightCount);
+template <> void computeWeightedSums(const int16_t* input, int32_t* sums, std::size_t count, const std::ptrdiff_t* offsets,
+                                     const int32_t* weights, std::size_t weightCount);
+template <> void computeWeightedSums(const int32_t* input, int32_t* sums, std::size_t count, const std::ptrdiff_t* offsets,
+                                     const int32_t* weights, std::size_t weightCount);
+template <> void computeMedians(const uint8_t* const* inputs, uint8_t* medians, std::size_t count, std::size_t inputCount);
+template <> void computeMedians(const int16_t* const* inputs, int16_t* medians, std::size_t count, std::size_t inputCount);
+template <> void computeMedians(const float* const* inputs, float* medians, std::size_t count, std::size_t inputCount);
+template <> void computeMinimums(const uint8_t* lhs, const uint8_t* rhs, uint8_t* res, std::size_t count);
+template <> void computeMinimums(const int16_t* lhs, const int16_t* rhs, int16_t* res, std::size_t count);
+template <> void computeMinimums(const float* lhs, const float* rhs, float* res, std::size_t count);
+template <> void computeMaximums(const uint8_t* lhs, const uint8_t* rhs, uint8_t* res, std::size_t count);
+template <> void computeMaximums(const int16_t* lhs, const int16_t* rhs, int16_t* res, std::size_t count);
+template <> void computeMaximums(const float* lhs, const float* rhs, float* res, std::size_t count);
+
+} // namespace Simd
+
+} // namespace Arcv
+
+#include "ArcV/Math/Simd.inl"
+
+#endif // ARCV_SIMD_HPP
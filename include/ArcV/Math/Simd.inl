@@ -0,0 +1,213 @@
+#include <limits>
+#include <algorithm>
+#include <type_traits>
+
+namespace Arcv {
+
+namespace Simd {
+
+// Type in which operations are carried out before being converted back; small integers are computed as floats,
+//  so that they can be saturated instead of wrapping around
+template <typename T> struct PromotedType { using Type = T; };
+template <> struct PromotedType<uint8_t> { using Type = float; };
+
+// Conversions are computed as floats when they represent exactly every value of both types, as doubles otherwise
+template <typename T> struct IsExactAsFloat : std::integral_constant<bool, std::is_same<T, float>::value
+                                                                        || (std::is_integral<T>::value && sizeof(T) <= 2)> {};
+template <typename TI, typename TO> using ConversionType = std::conditional_t<IsExactAsFloat<TI>::value && IsExactAsFloat<TO>::value,
+                                                                              float, double>;
+
+// Integers are clamped to their range and truncated; NaN (from 0 / 0) fails both comparisons, giving the lowest value
+// Integer values are compared as 64-bit ones, so that neither bound gets truncated by a narrower type
+template <typename T, typename TV>
+std::enable_if_t<!std::is_integral<T>::value, T> saturateCast(TV value) {
+  return static_cast<T>(value);
+}
+
+template <typename T, typename TV>
+std::enable_if_t<std::is_integral<T>::value, T> saturateCast(TV value) {
+  using Compared = std::conditional_t<std::is_integral<TV>::value, int64_t, TV>;
+
+  if (static_cast<Compared>(value) >= static_cast<Compared>(std::numeric_limits<T>::max()))
+    return std::numeric_limits<T>::max();
+  return (static_cast<Compared>(value) > static_cast<Compared>(std::numeric_limits<T>::lowest())
+          ? static_cast<T>(value) : std::numeric_limits<T>::lowest());
+}
+
+template <ElementwiseOperation Op, typename TL, typename TR>
+auto computeOperation(TL lhs, TR rhs) {
+  switch (Op) {
+    case ARCV_ELEMENTWISE_ADD:
+      return lhs + rhs;
+    case ARCV_ELEMENTWISE_SUB:
+      return lhs - rhs;
+    case ARCV_ELEMENTWISE_MUL:
+      return lhs * rhs;
+    case ARCV_ELEMENTWISE_DIV:
+    default:
+      return lhs / rhs;
+  }
+}
+
+template <ElementwiseOperation Op, typename T>
+void applyElementwiseReference(T* lhs, const T* rhs, std::size_t count) {
+  using Promoted = typename PromotedType<T>::Type;
+
+  for (std::size_t i = 0; i < count; ++i)
+    lhs[i] = saturateCast<T>(computeOperation<Op>(static_cast<Promoted>(lhs[i]), static_cast<Promoted>(rhs[i])));
+}
+
+template <ElementwiseOperation Op, typename T>
+void applyElementwiseReference(T* lhs, float val, std::size_t count) {
+  using Promoted = typename PromotedType<T>::Type;
+
+  for (std::size_t i = 0; i < count; ++i)
+    lhs[i] = saturateCast<T>(computeOperation<Op>(static_cast<Promoted>(lhs[i]), val));
+}
+
+template <typename T>
+void accumulateStatisticsReference(const T* pixels, std::size_t pixelCount, uint8_t channelCount, const double* shifts,
+                                   T* mins, T* maxs, double* sums, double* squaredSums) {
+  for (std::size_t pixelIndex = 0; pixelIndex < pixelCount; ++pixelIndex) {
+    for (uint8_t chan = 0; chan < channelCount; ++chan) {
+      const T value = pixels[pixelIndex * channelCount + chan];
+      const double shiftedValue = static_cast<double>(value) - shifts[chan];
+
+      mins[chan] = std::min(mins[chan], value);
+      maxs[chan] = std::max(maxs[chan], value);
+      sums[chan] += shiftedValue;
+      squaredSums[chan] += shiftedValue * shiftedValue;
+    }
+  }
+}
+
+template <typename TI, typename TO>
+void convertReference(const TI* input, TO* output, std::size_t count, float scale, float offset) {
+  using Computed = ConversionType<TI, TO>;
+
+  for (std::size_t i = 0; i < count; ++i)
+    output[i] = saturateCast<TO>(static_cast<Computed>(input[i]) * static_cast<Computed>(scale) + static_cast<Computed>(offset));
+}
+
+template <typename T>
+void deinterleaveReference(const T* pixels, std::size_t pixelCount, uint8_t channelCount, T* const* planes) {
+  for (std::size_t pixelIndex = 0; pixelIndex < pixelCount; ++pixelIndex) {
+    for (uint8_t chan = 0; chan < channelCount; ++chan)
+      planes[chan][pixelIndex] = pixels[pixelIndex * channelCount + chan];
+  }
+}
+
+template <typename T>
+void interleaveReference(const T* const* planes, std::size_t pixelCount, uint8_t channelCount, T* pixels) {
+  for (std::size_t pixelIndex = 0; pixelIndex < pixelCount; ++pixelIndex) {
+    for (uint8_t chan = 0; chan < channelCount; ++chan)
+      pixels[pixelIndex * channelCount + chan] = planes[chan][pixelIndex];
+  }
+}
+
+// Every result is summed in a register of its own, weights being applied in order
+template <typename TI, typename TA>
+void computeWeightedSumsReference(const TI* input, TA* sums, std::size_t count, const std::ptrdiff_t* offsets, const TA* weights,
+                                  std::size_t weightCount) {
+  for (std::size_t i = 0; i < count; ++i) {
+    TA sum = 0;
+
+    for (std::size_t weightIndex = 0; weightIndex < weightCount; ++weightIndex)
+      sum += weights[weightIndex] * static_cast<TA>(input[offsets[weightIndex] + i]);
+
+    sums[i] = sum;
+  }
+}
+
+// The smaller & larger values are selected as by vectors' minimum & maximum, which give the second value when unordered
+template <typename T>
+void computeMediansReference(const T* const* inputs, T* medians, std::size_t count, std::size_t inputCount) {
+  const MedianNetwork network = getMedianNetwork(inputCount);
+  T values[25];
+
+  for (std::size_t i = 0; i < count; ++i) {
+    for (std::size_t inputIndex = 0; inputIndex < inputCount; ++inputIndex)
+      values[inputIndex] = inputs[inputIndex][i];
+
+    for (std::size_t pairIndex = 0; pairIndex < network.pairCount; ++pairIndex) {
+      T& lowValue = values[network.pairs[pairIndex][0]];
+      T& highValue = values[network.pairs[pairIndex][1]];
+      const T low = (lowValue < highValue ? lowValue : highValue);
+      const T high = (lowValue > highValue ? lowValue : highValue);
+
+      lowValue = low;
+      highValue = high;
+    }
+
+    medians[i] = values[inputCount / 2];
+  }
+}
+
+// As for medians, unordered values give the second one
+template <typename T>
+void computeMinimumsReference(const T* lhs, const T* rhs, T* res, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i)
+    res[i] = (lhs[i] < rhs[i] ? lhs[i] : rhs[i]);
+}
+
+template <typename T>
+void computeMaximumsReference(const T* lhs, const T* rhs, T* res, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i)
+    res[i] = (lhs[i] > rhs[i] ? lhs[i] : rhs[i]);
+}
+
+template <ElementwiseOperation Op, typename T>
+void applyElementwise(T* lhs, const T* rhs, std::size_t count) {
+  applyElementwiseReference<Op>(lhs, rhs, count);
+}
+
+template <ElementwiseOperation Op, typename T>
+void applyElementwise(T* lhs, float val, std::size_t count) {
+  applyElementwiseReference<Op>(lhs, val, count);
+}
+
+template <typename T>
+void accumulateStatistics(const T* pixels, std::size_t pixelCount, uint8_t channelCount, const double* shifts,
+                          T* mins, T* maxs, double* sums, double* squaredSums) {
+  accumulateStatisticsReference(pixels, pixelCount, channelCount, shifts, mins, maxs, sums, squaredSums);
+}
+
+template <typename TI, typename TO>
+void convert(const TI* input, TO* output, std::size_t count, float scale, float offset) {
+  convertReference(input, output, count, scale, offset);
+}
+
+template <typename T>
+void deinterleave(const T* pixels, std::size_t pixelCount, uint8_t channelCount, T* const* planes) {
+  deinterleaveReference(pixels, pixelCount, channelCount, planes);
+}
+
+template <typename T>
+void interleave(const T* const* planes, std::size_t pixelCount, uint8_t channelCount, T* pixels) {
+  interleaveReference(planes, pixelCount, channelCount, pixels);
+}
+
+template <typename TI, typename TA>
+void computeWeightedSums(const TI* input, TA* sums, std::size_t count, const std::ptrdiff_t* offsets, const TA* weights,
+                         std::size_t weightCount) {
+  computeWeightedSumsReference(input, sums, count, offsets, weights, weightCount);
+}
+
+template <typename T>
+void computeMedians(const T* const* inputs, T* medians, std::size_t count, std::size_t inputCount) {
+  computeMediansReference(inputs, medians, count, inputCount);
+}
+
+template <typename T>
+void computeMinimums(const T* lhs, const T* rhs, T* res, std::size_t count) {
+  computeMinimumsReference(lhs, rhs, res, count);
+}
+
+template <typename T>
+void computeMaximums(const T* lhs, const T* rhs, T* res, std::size_t count) {
+  computeMaximumsReference(lhs, rhs, res, count);
+}
+
+} // namespace Simd
+
+} // namespace Arcv
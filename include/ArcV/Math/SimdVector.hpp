@@ -0,0 +1,141 @@
+#pragma once
+
+#ifndef ARCV_SIMDVECTOR_HPP
+#define ARCV_SIMDVECTOR_HPP
+
+#include "ArcV/Math/Simd.hpp"
+
+// Kernels are compiled for each instruction set through target attributes, whatever the flags of the whole build; they
+//  are only called once the CPU has been checked to support it
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ARCV_SIMD_X86
+#include <immintrin.h>
+
+#define ARCV_TARGET_SSE2 __attribute__((target("sse2")))
+#define ARCV_TARGET_AVX2 __attribute__((target("avx2")))
+#define ARCV_TARGET_AVX512 __attribute__((target("avx512f,avx512bw")))
+#endif
+
+namespace Arcv {
+
+namespace Simd {
+
+#ifdef ARCV_SIMD_X86
+
+// Vectors of 32-bit sums, as used by convolution kernels: narrower inputs are widened while loaded
+
+constexpr bool isPowerOfTwo(int value) { return (value > 0 && (value & (value - 1)) == 0); }
+constexpr int computeLog2(int value) { return (value > 1 ? 1 + computeLog2(value / 2) : 0); }
+
+///////////
+// AVX2 //
+/////////
+
+ARCV_TARGET_AVX2 inline void loadVector(const float* input, __m256& vector) { vector = _mm256_loadu_ps(input); }
+ARCV_TARGET_AVX2 inline void loadVector(const int32_t* input, __m256i& vector) {
+  vector = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input));
+}
+ARCV_TARGET_AVX2 inline void loadVector(const uint8_t* input, __m256i& vector) {
+  vector = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(input)));
+}
+ARCV_TARGET_AVX2 inline void loadVector(const int16_t* input, __m256i& vector) {
+  vector = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input)));
+}
+
+ARCV_TARGET_AVX2 inline void broadcastVector(float value, __m256& vector) { vector = _mm256_set1_ps(value); }
+ARCV_TARGET_AVX2 inline void broadcastVector(int32_t value, __m256i& vector) { vector = _mm256_set1_epi32(value); }
+
+ARCV_TARGET_AVX2 inline void storeVector(__m256 vector, float* output) { _mm256_storeu_ps(output, vector); }
+ARCV_TARGET_AVX2 inline void storeVector(__m256i vector, int32_t* output) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), vector); }
+
+// Multiplying & adding separately rather than with FMA, so that results match the reference ones bit for bit
+ARCV_TARGET_AVX2 inline __m256 multiplyAdd(__m256 sums, __m256 weight, __m256 values) {
+  return _mm256_add_ps(sums, _mm256_mul_ps(weight, values));
+}
+ARCV_TARGET_AVX2 inline __m256i multiplyAdd(__m256i sums, __m256i weight, __m256i values) {
+  return _mm256_add_epi32(sums, _mm256_mullo_epi32(weight, values));
+}
+
+// Adds Weight * values to sums, the weight being known at compile time: weights of -1 & 1 only need a subtraction or an
+//  addition, powers of 2 a shift for integers; results match multiplyAdd()'s, negating a product being exact
+template <int Weight>
+ARCV_TARGET_AVX2 inline __m256 addMultiple(__m256 sums, __m256 values) {
+  constexpr int absWeight = (Weight < 0 ? -Weight : Weight);
+  const __m256 multiples = (absWeight == 1 ? values : _mm256_mul_ps(values, _mm256_set1_ps(static_cast<float>(absWeight))));
+  return (Weight < 0 ? _mm256_sub_ps(sums, multiples) : _mm256_add_ps(sums, multiples));
+}
+template <int Weight>
+ARCV_TARGET_AVX2 inline __m256i addMultiple(__m256i sums, __m256i values) {
+  constexpr int absWeight = (Weight < 0 ? -Weight : Weight);
+  const __m256i multiples = (absWeight == 1 ? values
+                            : isPowerOfTwo(absWeight) ? _mm256_slli_epi32(values, computeLog2(absWeight))
+                                                      : _mm256_mullo_epi32(values, _mm256_set1_epi32(absWeight)));
+  return (Weight < 0 ? _mm256_sub_epi32(sums, multiples) : _mm256_add_epi32(sums, multiples));
+}
+
+/////////////
+// AVX512 //
+///////////
+
+// Masked conversions & comparisons are used with every lane enabled, since the unmasked ones make some GCC
+//  versions warn about their internal placeholder operand being uninitialized
+constexpr __mmask16 allLanes = 0xFFFF;
+
+ARCV_TARGET_AVX512 inline void loadVector(const float* input, __m512& vector) { vector = _mm512_loadu_ps(input); }
+ARCV_TARGET_AVX512 inline void loadVector(const int32_t* input, __m512i& vector) { vector = _mm512_loadu_si512(input); }
+ARCV_TARGET_AVX512 inline void loadVector(const uint8_t* input, __m512i& vector) {
+  vector = _mm512_maskz_cvtepu8_epi32(allLanes, _mm_loadu_si128(reinterpret_cast<const __m128i*>(input)));
+}
+ARCV_TARGET_AVX512 inline void loadVector(const int16_t* input, __m512i& vector) {
+  vector = _mm512_maskz_cvtepi16_epi32(allLanes, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input)));
+}
+
+ARCV_TARGET_AVX512 inline void broadcastVector(float value, __m512& vector) { vector = _mm512_set1_ps(value); }
+ARCV_TARGET_AVX512 inline void broadcastVector(int32_t value, __m512i& vector) { vector = _mm512_set1_epi32(value); }
+
+ARCV_TARGET_AVX512 inline void storeVector(__m512 vector, float* output) { _mm512_storeu_ps(output, vector); }
+ARCV_TARGET_AVX512 inline void storeVector(__m512i vector, int32_t* output) { _mm512_storeu_si512(output, vector); }
+
+// AVX-512 implying FMA, GCC would contract a plain multiplication & addition into one; the operations with an explicit
+//  rounding mode are kept as is
+ARCV_TARGET_AVX512 inline __m512 multiplyAdd(__m512 sums, __m512 weight, __m512 values) {
+  const __m512 products = _mm512_maskz_mul_round_ps(allLanes, weight, values, _MM_FROUND_CUR_DIRECTION);
+  return _mm512_maskz_add_round_ps(allLanes, sums, products, _MM_FROUND_CUR_DIRECTION);
+}
+ARCV_TARGET_AVX512 inline __m512i multiplyAdd(__m512i sums, __m512i weight, __m512i values) {
+  return _mm512_add_epi32(sums, _mm512_mullo_epi32(weight, values));
+}
+
+template <int Weight>
+ARCV_TARGET_AVX512 inline __m512 addMultiple(__m512 sums, __m512 values) {
+  constexpr int absWeight = (Weight < 0 ? -Weight : Weight);
+  const __m512 multiples = (absWeight == 1 ? values
+                                           : _mm512_maskz_mul_round_ps(allLanes, values, _mm512_set1_ps(static_cast<float>(absWeight)),
+                                                                       _MM_FROUND_CUR_DIRECTION));
+  return (Weight < 0 ? _mm512_maskz_sub_round_ps(allLanes, sums, multiples, _MM_FROUND_CUR_DIRECTION)
+                     : _mm512_maskz_add_round_ps(allLanes, sums, multiples, _MM_FROUND_CUR_DIRECTION));
+}
+template <int Weight>
+ARCV_TARGET_AVX512 inline __m512i addMultiple(__m512i sums, __m512i values) {
+  constexpr int absWeight = (Weight < 0 ? -Weight : Weight);
+  const __m512i multiples = (absWeight == 1 ? values
+                            : isPowerOfTwo(absWeight) ? _mm512_maskz_slli_epi32(allLanes, values, computeLog2(absWeight))
+                                                      : _mm512_mullo_epi32(values, _mm512_set1_epi32(absWeight)));
+  return (Weight < 0 ? _mm512_sub_epi32(sums, multiples) : _mm512_add_epi32(sums, multiples));
+}
+
+// Register holding the sums of the given type for the given instruction set; vector types used as template arguments
+//  losing their attributes, they are only named through this
+template <typename TA, SimdInstructionSet InstructionSet> struct SumVector;
+template <> struct SumVector<float, ARCV_SIMD_AVX2> { using Type = __m256; };
+template <> struct SumVector<int32_t, ARCV_SIMD_AVX2> { using Type = __m256i; };
+template <> struct SumVector<float, ARCV_SIMD_AVX512> { using Type = __m512; };
+template <> struct SumVector<int32_t, ARCV_SIMD_AVX512> { using Type = __m512i; };
+
+#endif // ARCV_SIMD_X86
+
+} // namespace Simd
+
+} // namespace Arcv
+
+#endif // ARCV_SIMDVECTOR_HPP
@@ -0,0 +1,65 @@
+#pragma once
+
+#ifndef ARCV_STATICKERNEL_HPP
+#define ARCV_STATICKERNEL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "ArcV/Math/Matrix.hpp"
+#include "ArcV/Math/PlanarMatrix.hpp"
+
+namespace Arcv {
+
+// Side of the smallest square kernel holding tapCount taps
+constexpr std::size_t computeKernelSize(std::size_t tapCount) {
+  std::size_t size = 1;
+  while (size * size < tapCount)
+    ++size;
+
+  return size;
+}
+
+// Square kernel of odd size whose integer taps, given row by row, are template parameters, results being divided by
+//  2^Shift; normalized kernels of small integers, such as binomial ones, are thus exact whatever the pixel type
+// The taps being known at compile time, their loop is fully unrolled: zero taps are skipped & taps of -1, 1 or powers
+//  of 2 applied with additions, subtractions & shifts instead of multiplications
+template <uint8_t Shift, int... Taps>
+struct StaticKernel {
+  using TapSequence = std::integer_sequence<int, Taps...>;
+
+  static constexpr uint8_t FractionBits = Shift;
+  static constexpr std::size_t Size = computeKernelSize(sizeof...(Taps));
+
+  static_assert(Size * Size == sizeof...(Taps) && Size % 2 == 1, "Error: Static kernels must be square ones of odd size");
+};
+
+// Convolves as with a Matrix<float> kernel, without allocating nor converting any weight; integer pixels are multiplied by
+//  the taps as is, the sum of whose absolute values must then stay below 2^23 for uint8_t & 2^16 for int16_t inputs
+template <typename T, uint8_t Shift, int... Taps>
+Matrix<T> convolve(const MatrixView<const T>& mat, StaticKernel<Shift, Taps...> kernel,
+                   BorderType border = ARCV_BORDER_TYPE_CONSTANT, float borderValue = 0.f);
+template <typename TI, typename TO, uint8_t Shift, int... Taps>
+void convolve(const MatrixView<const TI>& mat, StaticKernel<Shift, Taps...> kernel, Matrix<TO>& res,
+              BorderType border = ARCV_BORDER_TYPE_CONSTANT, float borderValue = 0.f);
+template <typename T, uint8_t Shift, int... Taps>
+PlanarMatrix<T> convolve(const PlanarMatrix<T>& mat, StaticKernel<Shift, Taps...> kernel,
+                         BorderType border = ARCV_BORDER_TYPE_CONSTANT, float borderValue = 0.f);
+template <typename TI, typename TO, uint8_t Shift, int... Taps>
+void convolve(const PlanarMatrix<TI>& mat, StaticKernel<Shift, Taps...> kernel, PlanarMatrix<TO>& res,
+              BorderType border = ARCV_BORDER_TYPE_CONSTANT, float borderValue = 0.f);
+
+namespace Simd {
+
+// Computes sums[i] as computeWeightedSums() does, with the kernel's taps as weights; called for the rows of a convolution
+template <typename Kernel, typename TI, typename TA>
+void computeStaticWeightedSums(const TI* input, TA* sums, std::size_t count, const std::ptrdiff_t* offsets);
+
+} // namespace Simd
+
+} // namespace Arcv
+
+#include "ArcV/Math/StaticKernel.inl"
+
+#endif // ARCV_STATICKERNEL_HPP
@@ -0,0 +1,161 @@
+#include "ArcV/Math/SimdVector.hpp"
+
+namespace Arcv {
+
+namespace Simd {
+
+// Each tap is expanded in order from the kernel's template parameters, zero ones being discarded at compile time
+template <int... Taps, std::size_t... TapIndices, typename TI, typename TA>
+void computeStaticWeightedSumsReference(std::integer_sequence<int, Taps...>, std::index_sequence<TapIndices...>,
+                                        const TI* input, TA* sums, std::size_t count, const std::ptrdiff_t* offsets) {
+  for (std::size_t i = 0; i < count; ++i) {
+    TA sum = 0;
+
+    const int expansion[] = { 0, (Taps != 0 ? (sum += static_cast<TA>(Taps) * static_cast<TA>(input[offsets[TapIndices] + i]), 0) : 0)... };
+    static_cast<void>(expansion);
+
+    sums[i] = sum;
+  }
+}
+
+#ifdef ARCV_SIMD_X86
+
+template <int Tap, typename TA, typename TI>
+ARCV_TARGET_AVX2 inline void addTapAvx2(typename SumVector<TA, ARCV_SIMD_AVX2>::Type (&vectors)[4], const TI* input) {
+  if (Tap == 0)
+    return;
+
+  for (uint8_t vecIndex = 0; vecIndex < 4; ++vecIndex) {
+    typename SumVector<TA, ARCV_SIMD_AVX2>::Type values;
+    loadVector(input + vecIndex * 8, values);
+    vectors[vecIndex] = addMultiple<Tap>(vectors[vecIndex], values);
+  }
+}
+
+// Four vectors of sums stay in registers while going through the unrolled taps, as for runtime weights
+template <int... Taps, std::size_t... TapIndices, typename TI, typename TA>
+ARCV_TARGET_AVX2 void computeStaticWeightedSumsAvx2(std::integer_sequence<int, Taps...> taps, std::index_sequence<TapIndices...> tapIndices,
+                                                    const TI* input, TA* sums, std::size_t count, const std::ptrdiff_t* offsets) {
+  using Vector = typename SumVector<TA, ARCV_SIMD_AVX2>::Type;
+
+  Vector zero;
+  broadcastVector(TA(0), zero);
+
+  std::size_t i = 0;
+  for (; i + 32 <= count; i += 32) {
+    Vector vectors[4] = { zero, zero, zero, zero };
+
+    const int expansion[] = { 0, (addTapAvx2<Taps, TA>(vectors, input + offsets[TapIndices] + i), 0)... };
+    static_cast<void>(expansion);
+
+    for (uint8_t vecIndex = 0; vecIndex < 4; ++vecIndex)
+      storeVector(vectors[vecIndex], sums + i + vecIndex * 8);
+  }
+
+  computeStaticWeightedSumsReference(taps, tapIndices, input + i, sums + i, count - i, offsets);
+}
+
+template <int Tap, typename TA, typename TI>
+ARCV_TARGET_AVX512 inline void addTapAvx512(typename SumVector<TA, ARCV_SIMD_AVX512>::Type (&vectors)[4], const TI* input) {
+  if (Tap == 0)
+    return;
+
+  for (uint8_t vecIndex = 0; vecIndex < 4; ++vecIndex) {
+    typename SumVector<TA, ARCV_SIMD_AVX512>::Type values;
+    loadVector(input + vecIndex * 16, values);
+    vectors[vecIndex] = addMultiple<Tap>(vectors[vecIndex], values);
+  }
+}
+
+template <int... Taps, std::size_t... TapIndices, typename TI, typename TA>
+ARCV_TARGET_AVX512 void computeStaticWeightedSumsAvx512(std::integer_sequence<int, Taps...> taps, std::index_sequence<TapIndices...> tapIndices,
+                                                        const TI* input, TA* sums, std::size_t count, const std::ptrdiff_t* offsets) {
+  using Vector = typename SumVector<TA, ARCV_SIMD_AVX512>::Type;
+
+  Vector zero;
+  broadcastVector(TA(0), zero);
+
+  std::size_t i = 0;
+  for (; i + 64 <= count; i += 64) {
+    Vector vectors[4] = { zero, zero, zero, zero };
+
+    const int expansion[] = { 0, (addTapAvx512<Taps, TA>(vectors, input + offsets[TapIndices] + i), 0)... };
+    static_cast<void>(expansion);
+
+    for (uint8_t vecIndex = 0; vecIndex < 4; ++vecIndex)
+      storeVector(vectors[vecIndex], sums + i + vecIndex * 16);
+  }
+
+  computeStaticWeightedSumsAvx2(taps, tapIndices, input + i, sums + i, count - i, offsets);
+}
+
+#endif // ARCV_SIMD_X86
+
+// SSE2 having no 32-bit multiplication nor widening loads, it keeps the reference loop as runtime weights do for integers
+template <typename Kernel, typename TI, typename TA>
+void computeStaticWeightedSums(const TI* input, TA* sums, std::size_t count, const std::ptrdiff_t* offsets) {
+  const typename Kernel::TapSequence taps;
+  const std::make_index_sequence<Kernel::Size * Kernel::Size> tapIndices;
+
+  switch (getInstructionSet()) {
+#ifdef ARCV_SIMD_X86
+    case ARCV_SIMD_AVX512:
+      computeStaticWeightedSumsAvx512(taps, tapIndices, input, sums, count, offsets);
+      break;
+
+    case ARCV_SIMD_AVX2:
+      computeStaticWeightedSumsAvx2(taps, tapIndices, input, sums, count, offsets);
+      break;
+#endif
+
+    default:
+      computeStaticWeightedSumsReference(taps, tapIndices, input, sums, count, offsets);
+      break;
+  }
+}
+
+} // namespace Simd
+
+template <typename T, uint8_t Shift, int... Taps>
+Matrix<T> convolve(const MatrixView<const T>& mat, StaticKernel<Shift, Taps...> kernel, BorderType border, float borderValue) {
+  Matrix<T> res;
+  convolve(mat, kernel, res, border, borderValue);
+
+  return res;
+}
+
+template <typename TI, typename TO, uint8_t Shift, int... Taps>
+void convolve(const MatrixView<const TI>& mat, StaticKernel<Shift, Taps...>, Matrix<TO>& res, BorderType border, float borderValue) {
+  using Kernel = StaticKernel<Shift, Taps...>;
+
+  assert(("Error: Convolution cannot be done in place",
+          static_cast<const void*>(res.getData().data()) != static_cast<const void*>(mat.getData())));
+
+  res.reshape(mat.getWidth(), mat.getHeight(), mat.getChannelCount(), mat.getImgBitDepth(), mat.getColorspace(), res.hasPaddedRows());
+  convolveRows<TI, TO>(mat, Kernel::Size, Kernel::FractionBits, &Simd::computeStaticWeightedSums<Kernel, TI, ConvolutionSum<TI>>,
+               res.getView(), border, borderValue);
+}
+
+template <typename T, uint8_t Shift, int... Taps>
+PlanarMatrix<T> convolve(const PlanarMatrix<T>& mat, StaticKernel<Shift, Taps...> kernel, BorderType border, float borderValue) {
+  PlanarMatrix<T> res(mat.getWidth(), mat.getHeight(), mat.getChannelCount(), mat.getImgBitDepth(), mat.getColorspace(), mat.hasPaddedRows());
+  convolve(mat, kernel, res, border, borderValue);
+
+  return res;
+}
+
+template <typename TI, typename TO, uint8_t Shift, int... Taps>
+void convolve(const PlanarMatrix<TI>& mat, StaticKernel<Shift, Taps...>, PlanarMatrix<TO>& res, BorderType border, float borderValue) {
+  using Kernel = StaticKernel<Shift, Taps...>;
+
+  assert(("Error: Convolution cannot be done in place",
+          static_cast<const void*>(res.getData().data()) != static_cast<const void*>(mat.getData().data())));
+
+  res.reshape(mat.getWidth(), mat.getHeight(), mat.getChannelCount(), mat.getImgBitDepth(), mat.getColorspace(), res.hasPaddedRows());
+
+  for (uint8_t chan = 0; chan < mat.getChannelCount(); ++chan)
+    convolveRows<TI, TO>(mat.getPlane(chan), Kernel::Size, Kernel::FractionBits, &Simd::computeStaticWeightedSums<Kernel, TI, ConvolutionSum<TI>>,
+                         res.getPlane(chan), border, borderValue);
+}
+
+} // namespace Arcv
@@ -5,6 +5,8 @@
 
 #include <vector>
 
+#include "ArcV/Math/Simd.hpp"
+
 namespace Arcv {
 
 template <typename T = float>
@@ -91,15 +91,13 @@ template <typename T>
 Vector<T>& Vector<T>::operator+=(const Vector& vec) {
   assert(("Error: Vectors aren't the same size", data.size() == vec.getData().size()));
 
-  for (std::size_t i = 0; i < data.size(); ++i)
-    data[i] += vec.getData()[i];
+  Simd::applyElementwise<ARCV_ELEMENTWISE_ADD>(data.data(), vec.getData().data(), data.size());
   return *this;
 }
 
 template <typename T>
 Vector<T>& Vector<T>::operator+=(float val) {
-  for (T& it : data)
-    it += val;
+  Simd::applyElementwise<ARCV_ELEMENTWISE_ADD>(data.data(), val, data.size());
   return *this;
 }
 
@@ -107,15 +105,13 @@ template <typename T>
 Vector<T>& Vector<T>::operator-=(const Vector& vec) {
   assert(("Error: Vectors aren't the same size", data.size() == vec.getData().size()));
 
-  for (std::size_t i = 0; i < data.size(); ++i)
-    data[i] -= vec.getData()[i];
+  Simd::applyElementwise<ARCV_ELEMENTWISE_SUB>(data.data(), vec.getData().data(), data.size());
   return *this;
 }
 
 template <typename T>
 Vector<T>& Vector<T>::operator-=(float val) {
-  for (T& it : data)
-    it -= val;
+  Simd::applyElementwise<ARCV_ELEMENTWISE_SUB>(data.data(), val, data.size());
   return *this;
 }
 
@@ -123,15 +119,13 @@ template <typename T>
 Vector<T>& Vector<T>::operator*=(const Vector& vec) {
   assert(("Error: Vectors aren't the same size", data.size() == vec.getData().size()));
 
-  for (std::size_t i = 0; i < data.size(); ++i)
-    data[i] *= vec.getData()[i];
+  Simd::applyElementwise<ARCV_ELEMENTWISE_MUL>(data.data(), vec.getData().data(), data.size());
   return *this;
 }
 
 template <typename T>
 Vector<T>& Vector<T>::operator*=(float val) {
-  for (T& it : data)
-    it *= val;
+  Simd::applyElementwise<ARCV_ELEMENTWISE_MUL>(data.data(), val, data.size());
   return *this;
 }
 
@@ -139,15 +133,13 @@ template <typename T>
 Vector<T>& Vector<T>::operator/=(const Vector& vec) {
   assert(("Error: Vectors aren't the same size", data.size() == vec.getData().size()));
 
-  for (std::size_t i = 0; i < data.size(); ++i)
-    data[i] /= vec.getData()[i];
+  Simd::applyElementwise<ARCV_ELEMENTWISE_DIV>(data.data(), vec.getData().data(), data.size());
   return *this;
 }
 
 template <typename T>
 Vector<T>& Vector<T>::operator/=(float val) {
-  for (T& it : data)
-    it /= val;
+  Simd::applyElementwise<ARCV_ELEMENTWISE_DIV>(data.data(), val, data.size());
   return *this;
 }
 
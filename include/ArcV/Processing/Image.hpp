@@ -4,8 +4,11 @@
 #define ARCV_IMAGE_HPP
 
 #include <string>
+#include <type_traits>
 
 #include "ArcV/Math/Matrix.hpp"
+#include "ArcV/Math/BitMatrix.hpp"
+#include "ArcV/Math/PlanarMatrix.hpp"
 
 enum ImageType { ARCV_IMAGE_TYPE_JPEG = 0,
                  ARCV_IMAGE_TYPE_PNG };
@@ -22,24 +25,116 @@ enum ThreshType { ARCV_THRESH_TYPE_BINARY = 0,
                   ARCV_THRESH_TYPE_HYSTERESIS,
                   ARCV_THRESH_TYPE_HYSTERESIS_AUTO };
 
+enum MorphologyType { ARCV_MORPHOLOGY_TYPE_EROSION = 0,
+                      ARCV_MORPHOLOGY_TYPE_DILATION,
+                      ARCV_MORPHOLOGY_TYPE_OPENING,
+                      ARCV_MORPHOLOGY_TYPE_CLOSING,
+                      ARCV_MORPHOLOGY_TYPE_TOP_HAT,
+                      ARCV_MORPHOLOGY_TYPE_GRADIENT };
+
 namespace Arcv {
 
 namespace Image {
 
-Matrix<> read(const std::string& fileName);
-void write(const Matrix<>& mat, const std::string& fileName);
-template <Colorspace C> Matrix<> changeColorspace(Matrix<> mat);
-template <FilterType F> Matrix<> applyFilter(Matrix<> mat);
-template <DetectorType D> Matrix<> applyDetector(const Matrix<>& mat);
-template <ThreshType Thresh> Matrix<> threshold(const Matrix<>& mat, std::initializer_list<float> lowerBounds = {},
-                                                                     std::initializer_list<float> upperBounds = {});
+// Overloads taking a result matrix write into it, reusing its memory if large enough; unless stated
+//  otherwise, it must not be the input matrix
+// Every operation is available on float, uint8_t & int16_t pixels, integer ones being processed in fixed point
+template <typename T = float> Matrix<T> read(const std::string& fileName);
+// Images are stored with 8 bits per channel, other pixel types being saturated
+template <typename T> void write(const Matrix<T>& mat, const std::string& fileName);
+template <Colorspace C, typename T> Matrix<T> changeColorspace(const Matrix<T>& mat);
+// Can be done in place (res being mat) when the channel count does not increase
+template <Colorspace C, typename T> void changeColorspace(const Matrix<T>& mat, Matrix<T>& res);
+// Planar pixels can only be converted to gray & HSV, in place as well
+template <Colorspace C, typename T> PlanarMatrix<T> changeColorspace(const PlanarMatrix<T>& mat);
+template <Colorspace C, typename T> void changeColorspace(const PlanarMatrix<T>& mat, PlanarMatrix<T>& res);
+template <FilterType F, typename T> Matrix<T> applyFilter(const Matrix<T>& mat);
+template <FilterType F, typename T> Matrix<std::remove_const_t<T>> applyFilter(const MatrixView<T>& mat);
+template <FilterType F, typename T> void applyFilter(const Matrix<T>& mat, Matrix<T>& res);
+template <FilterType F, typename T> void applyFilter(const MatrixView<const T>& mat, Matrix<T>& res);
+// Blurs by a Gaussian of standard deviations sigmaX & sigmaY, edges being replicated; sigmas must be at least 0.5, or 0 to
+//  leave a direction unblurred. Sigmas of at least 2 go through Young & van Vliet's recursive filters, whose cost per
+//  element doesn't depend on them but which only approximate a Gaussian: on values from 0 to 255, results differ from
+//  an exact Gaussian's by up to 4.6 across steps & 14 on checkerboards for sigmas of 2 to 6, decreasing to about 2 & 6
+//  at 10 & to about 1.3 at 20. Smaller sigmas are convolved by sampled kernels, within 0.5 of an exact Gaussian
+template <typename T> Matrix<T> gaussianBlur(const Matrix<T>& mat, float sigmaX, float sigmaY);
+template <typename T> Matrix<std::remove_const_t<T>> gaussianBlur(const MatrixView<T>& mat, float sigmaX, float sigmaY);
+template <typename T> void gaussianBlur(const Matrix<T>& mat, Matrix<T>& res, float sigmaX, float sigmaY);
+template <typename T> void gaussianBlur(const MatrixView<const T>& mat, Matrix<T>& res, float sigmaX, float sigmaY);
+// Replaces every element by the median of its kernelSize x kernelSize neighbourhood, edges being replicated; the size must
+//  be odd. 3x3 & 5x5 medians go through vectorized sorting networks, larger uint8_t ones through Perreault & Hébert's
+//  histograms, whose cost per element doesn't depend on the size; other pixels' larger neighbourhoods are partially sorted
+template <typename T> Matrix<T> medianBlur(const Matrix<T>& mat, std::size_t kernelSize);
+template <typename T> Matrix<std::remove_const_t<T>> medianBlur(const MatrixView<T>& mat, std::size_t kernelSize);
+template <typename T> void medianBlur(const Matrix<T>& mat, Matrix<T>& res, std::size_t kernelSize);
+template <typename T> void medianBlur(const MatrixView<const T>& mat, Matrix<T>& res, std::size_t kernelSize);
+// Edge-preserving smoothing, averaging every element's neighbours weighted by Gaussians of their distance & of their
+//  difference of value, of standard deviations sigmaSpace (in elements, at least 1) & sigmaRange (in values); pixels are
+//  compared by the mean of their channels. Approximated with Chen et al.'s bilateral grid, downsampled by the sigmas, whose
+//  cost per element barely depends on them; small sigmas make the grid large
+template <typename T> Matrix<T> bilateralFilter(const Matrix<T>& mat, float sigmaSpace, float sigmaRange);
+template <typename T> Matrix<std::remove_const_t<T>> bilateralFilter(const MatrixView<T>& mat, float sigmaSpace, float sigmaRange);
+template <typename T> void bilateralFilter(const Matrix<T>& mat, Matrix<T>& res, float sigmaSpace, float sigmaRange);
+template <typename T> void bilateralFilter(const MatrixView<const T>& mat, Matrix<T>& res, float sigmaSpace, float sigmaRange);
+// He et al.'s guided filter: every (2 * radius + 1)^2 window of the matrix is fitted as a linear transform of the guide's,
+//  regularized by epsilon (in squared values), smoothing the matrix while keeping the guide's edges. The guide has either
+//  one channel or as many as the matrix, & can be the matrix itself. Box filters make its cost independent of the radius;
+//  a subsampling factor above 1 fits the transforms on downsampled matrices, as He & Sun's fast guided filter does
+template <typename T> Matrix<T> guidedFilter(const Matrix<T>& mat, const Matrix<T>& guide, std::size_t radius, float epsilon,
+                                             std::size_t subsampling = 1);
+template <typename T> void guidedFilter(const Matrix<T>& mat, const Matrix<T>& guide, Matrix<T>& res, std::size_t radius, float epsilon,
+                                        std::size_t subsampling = 1);
+template <typename T> void guidedFilter(const MatrixView<const T>& mat, const MatrixView<const T>& guide, Matrix<T>& res,
+                                        std::size_t radius, float epsilon, std::size_t subsampling = 1);
+// Morphological filters by a kernelWidth x kernelHeight rectangle, whose sizes must be odd: erosion & dilation give the
+//  minimum & maximum of every element's neighbourhood, edges being replicated; opening dilates the erosion & closing
+//  erodes the dilation, top-hat subtracts the opening from the matrix & gradient the erosion from the dilation
+// Each direction goes through van Herk & Gil-Werman's algorithm, costing 3 comparisons per element whatever the sizes
+template <MorphologyType M, typename T> Matrix<T> applyMorphology(const Matrix<T>& mat, std::size_t kernelWidth, std::size_t kernelHeight);
+template <MorphologyType M, typename T> Matrix<std::remove_const_t<T>> applyMorphology(const MatrixView<T>& mat, std::size_t kernelWidth,
+                                                                                        std::size_t kernelHeight);
+template <MorphologyType M, typename T> void applyMorphology(const Matrix<T>& mat, Matrix<T>& res, std::size_t kernelWidth, std::size_t kernelHeight);
+template <MorphologyType M, typename T> void applyMorphology(const MatrixView<const T>& mat, Matrix<T>& res, std::size_t kernelWidth,
+                                                             std::size_t kernelHeight);
+// Binary masks are processed 64 elements at a time, rows being combined by words & elements within rows by shifts
+template <MorphologyType M> BitMatrix applyMorphology(const BitMatrix& mask, std::size_t kernelWidth, std::size_t kernelHeight);
+template <MorphologyType M> void applyMorphology(const BitMatrix& mask, BitMatrix& res, std::size_t kernelWidth, std::size_t kernelHeight);
+template <DetectorType D, typename T> Matrix<T> applyDetector(const Matrix<T>& mat);
+template <DetectorType D, typename T> void applyDetector(const Matrix<T>& mat, Matrix<T>& res);
+// Hysteresis thresholding keeps the elements reaching the upper bound, & those reaching the lower one that are linked to
+//  them by a chain of such elements, 8-connected; each element is visited at most once. Rows are split into bands tracked
+//  by several threads, edges crossing their boundaries being followed afterwards. The automatic variant takes the first
+//  channel's population standard deviation as the lower bound & adds 30 to it for the upper one
+template <ThreshType Thresh, typename T> Matrix<T> threshold(const Matrix<T>& mat, std::initializer_list<float> lowerBounds = {},
+                                                                               std::initializer_list<float> upperBounds = {});
+// Binary thresholding can be done in place
+template <ThreshType Thresh, typename T> void threshold(const Matrix<T>& mat, Matrix<T>& res, std::initializer_list<float> lowerBounds = {},
+                                                                                          std::initializer_list<float> upperBounds = {});
 template <typename T> Matrix<T> rotateLeft(const Matrix<T>& mat);
+template <typename T> Matrix<std::remove_const_t<T>> rotateLeft(const MatrixView<T>& mat);
+template <typename T> void rotateLeft(const Matrix<T>& mat, Matrix<T>& res);
+template <typename T> void rotateLeft(const MatrixView<T>& mat, Matrix<std::remove_const_t<T>>& res);
 template <typename T> Matrix<T> rotateRight(const Matrix<T>& mat);
+template <typename T> Matrix<std::remove_const_t<T>> rotateRight(const MatrixView<T>& mat);
+template <typename T> void rotateRight(const Matrix<T>& mat, Matrix<T>& res);
+template <typename T> void rotateRight(const MatrixView<T>& mat, Matrix<std::remove_const_t<T>>& res);
 template <typename T> Matrix<T> reverse(const Matrix<T>& mat);
+template <typename T> Matrix<std::remove_const_t<T>> reverse(const MatrixView<T>& mat);
+template <typename T> void reverse(const Matrix<T>& mat, Matrix<T>& res);
+template <typename T> void reverse(const MatrixView<T>& mat, Matrix<std::remove_const_t<T>>& res);
 template <typename T> Matrix<T> horizontalFlip(const Matrix<T>& mat);
+template <typename T> Matrix<std::remove_const_t<T>> horizontalFlip(const MatrixView<T>& mat);
+template <typename T> void horizontalFlip(const Matrix<T>& mat, Matrix<T>& res);
+template <typename T> void horizontalFlip(const MatrixView<T>& mat, Matrix<std::remove_const_t<T>>& res);
 template <typename T> Matrix<T> verticalFlip(const Matrix<T>& mat);
+template <typename T> MatrixView<T> verticalFlip(const MatrixView<T>& mat);
+template <typename T> void verticalFlip(const Matrix<T>& mat, Matrix<T>& res);
 template <typename T> Matrix<T> region(const Matrix<T>& mat, std::size_t widthBegin, std::size_t widthEnd,
                                                              std::size_t heightBegin, std::size_t heightEnd);
+template <typename T> MatrixView<T> region(const MatrixView<T>& mat, std::size_t widthBegin, std::size_t widthEnd,
+                                                                     std::size_t heightBegin, std::size_t heightEnd);
+template <typename T> void region(const Matrix<T>& mat, Matrix<T>& res, std::size_t widthBegin, std::size_t widthEnd,
+                                                                       std::size_t heightBegin, std::size_t heightEnd);
 
 } // namespace Image
 
@@ -3,109 +3,331 @@
 
 namespace Arcv {
 
+template <Colorspace C, typename T>
+Matrix<T> Image::changeColorspace(const Matrix<T>& mat) {
+  Matrix<T> res;
+  changeColorspace<C>(mat, res);
+
+  return res;
+}
+
+template <Colorspace C, typename T>
+PlanarMatrix<T> Image::changeColorspace(const PlanarMatrix<T>& mat) {
+  PlanarMatrix<T> res;
+  changeColorspace<C>(mat, res);
+
+  return res;
+}
+
+template <FilterType F, typename T>
+Matrix<T> Image::applyFilter(const Matrix<T>& mat) {
+  return applyFilter<F>(mat.getView());
+}
+
+template <FilterType F, typename T>
+Matrix<std::remove_const_t<T>> Image::applyFilter(const MatrixView<T>& mat) {
+  Matrix<std::remove_const_t<T>> res;
+  applyFilter<F>(MatrixView<const T>(mat), res);
+
+  return res;
+}
+
+template <FilterType F, typename T>
+void Image::applyFilter(const Matrix<T>& mat, Matrix<T>& res) {
+  applyFilter<F>(mat.getView(), res);
+}
+
 template <typename T>
-Matrix<T> Image::rotateLeft(const Matrix<T>& mat) {
-  Matrix<T> res(mat.getHeight(), mat.getWidth(), mat.getChannelCount(), mat.getImgBitDepth(), mat.getColorspace());
+Matrix<T> Image::gaussianBlur(const Matrix<T>& mat, float sigmaX, float sigmaY) {
+  return gaussianBlur(mat.getView(), sigmaX, sigmaY);
+}
 
-  for (std::size_t hIndex = 0, resWIndex = 0; hIndex < mat.getHeight(), resWIndex < res.getWidth(); ++hIndex, ++resWIndex) {
-    for (std::size_t wIndex = 0, resHIndex = res.getHeight() - 1; wIndex < mat.getWidth(), resHIndex > 0; ++wIndex, --resHIndex) {
-      const std::size_t matIndex = (hIndex * mat.getWidth() + wIndex) * mat.getChannelCount();
-      const std::size_t resIndex = (resHIndex * res.getWidth() + resWIndex) * res.getChannelCount();
+template <typename T>
+Matrix<std::remove_const_t<T>> Image::gaussianBlur(const MatrixView<T>& mat, float sigmaX, float sigmaY) {
+  Matrix<std::remove_const_t<T>> res;
+  gaussianBlur(MatrixView<const T>(mat), res, sigmaX, sigmaY);
 
-      for (uint8_t chan = 0; chan < mat.getChannelCount(); ++chan)
-        res[resIndex + chan] = mat[matIndex + chan];
-    }
-  }
+  return res;
+}
+
+template <typename T>
+void Image::gaussianBlur(const Matrix<T>& mat, Matrix<T>& res, float sigmaX, float sigmaY) {
+  gaussianBlur(mat.getView(), res, sigmaX, sigmaY);
+}
+
+template <typename T>
+Matrix<T> Image::medianBlur(const Matrix<T>& mat, std::size_t kernelSize) {
+  return medianBlur(mat.getView(), kernelSize);
+}
+
+template <typename T>
+Matrix<std::remove_const_t<T>> Image::medianBlur(const MatrixView<T>& mat, std::size_t kernelSize) {
+  Matrix<std::remove_const_t<T>> res;
+  medianBlur(MatrixView<const T>(mat), res, kernelSize);
 
   return res;
 }
 
 template <typename T>
-Matrix<T> Image::rotateRight(const Matrix<T>& mat) {
-  Matrix<T> res(mat.getHeight(), mat.getWidth(), mat.getChannelCount(), mat.getImgBitDepth(), mat.getColorspace());
+void Image::medianBlur(const Matrix<T>& mat, Matrix<T>& res, std::size_t kernelSize) {
+  medianBlur(mat.getView(), res, kernelSize);
+}
 
-  for (std::size_t hIndex = 0, resWIndex = res.getWidth() - 1; hIndex < mat.getHeight(), resWIndex > 0; ++hIndex, --resWIndex) {
-    for (std::size_t wIndex = 0, resHIndex = 0; wIndex < mat.getWidth(), resHIndex < res.getHeight(); ++wIndex, ++resHIndex) {
-      const std::size_t matIndex = (hIndex * mat.getWidth() + wIndex) * mat.getChannelCount();
-      const std::size_t resIndex = (resHIndex * res.getWidth() + resWIndex) * res.getChannelCount();
+template <typename T>
+Matrix<T> Image::bilateralFilter(const Matrix<T>& mat, float sigmaSpace, float sigmaRange) {
+  return bilateralFilter(mat.getView(), sigmaSpace, sigmaRange);
+}
 
-      for (uint8_t chan = 0; chan < mat.getChannelCount(); ++chan)
-        res[resIndex + chan] = mat[matIndex + chan];
-    }
-  }
+template <typename T>
+Matrix<std::remove_const_t<T>> Image::bilateralFilter(const MatrixView<T>& mat, float sigmaSpace, float sigmaRange) {
+  Matrix<std::remove_const_t<T>> res;
+  bilateralFilter(MatrixView<const T>(mat), res, sigmaSpace, sigmaRange);
 
   return res;
 }
 
 template <typename T>
-Matrix<T> Image::reverse(const Matrix<T>& mat) {
-  Matrix<T> res(mat.getWidth(), mat.getHeight(), mat.getChannelCount(), mat.getImgBitDepth(), mat.getColorspace());
+void Image::bilateralFilter(const Matrix<T>& mat, Matrix<T>& res, float sigmaSpace, float sigmaRange) {
+  bilateralFilter(mat.getView(), res, sigmaSpace, sigmaRange);
+}
 
-  for (std::size_t hIndex = 0, resHIndex = res.getHeight() - 1; hIndex < mat.getHeight(), resHIndex > 0; ++hIndex, --resHIndex) {
-    for (std::size_t wIndex = 0, resWIndex = res.getWidth() - 1; wIndex < mat.getWidth(), resWIndex > 0; ++wIndex, --resWIndex) {
-      const std::size_t matIndex = (hIndex * mat.getWidth() + wIndex) * mat.getChannelCount();
-      const std::size_t resIndex = (resHIndex * res.getWidth() + resWIndex) * res.getChannelCount();
+template <typename T>
+Matrix<T> Image::guidedFilter(const Matrix<T>& mat, const Matrix<T>& guide, std::size_t radius, float epsilon, std::size_t subsampling) {
+  Matrix<T> res;
+  guidedFilter(mat.getView(), guide.getView(), res, radius, epsilon, subsampling);
 
-      for (uint8_t chan = 0; chan < mat.getChannelCount(); ++chan)
-        res[resIndex + chan] = mat[matIndex + chan];
-    }
-  }
+  return res;
+}
+
+template <typename T>
+void Image::guidedFilter(const Matrix<T>& mat, const Matrix<T>& guide, Matrix<T>& res, std::size_t radius, float epsilon,
+                         std::size_t subsampling) {
+  guidedFilter(mat.getView(), guide.getView(), res, radius, epsilon, subsampling);
+}
+
+template <MorphologyType M, typename T>
+Matrix<T> Image::applyMorphology(const Matrix<T>& mat, std::size_t kernelWidth, std::size_t kernelHeight) {
+  return applyMorphology<M>(mat.getView(), kernelWidth, kernelHeight);
+}
+
+template <MorphologyType M, typename T>
+Matrix<std::remove_const_t<T>> Image::applyMorphology(const MatrixView<T>& mat, std::size_t kernelWidth, std::size_t kernelHeight) {
+  Matrix<std::remove_const_t<T>> res;
+  applyMorphology<M>(MatrixView<const T>(mat), res, kernelWidth, kernelHeight);
+
+  return res;
+}
+
+template <MorphologyType M, typename T>
+void Image::applyMorphology(const Matrix<T>& mat, Matrix<T>& res, std::size_t kernelWidth, std::size_t kernelHeight) {
+  applyMorphology<M>(mat.getView(), res, kernelWidth, kernelHeight);
+}
+
+template <MorphologyType M>
+BitMatrix Image::applyMorphology(const BitMatrix& mask, std::size_t kernelWidth, std::size_t kernelHeight) {
+  BitMatrix res;
+  applyMorphology<M>(mask, res, kernelWidth, kernelHeight);
+
+  return res;
+}
+
+template <DetectorType D, typename T>
+Matrix<T> Image::applyDetector(const Matrix<T>& mat) {
+  Matrix<T> res;
+  applyDetector<D>(mat, res);
+
+  return res;
+}
+
+template <ThreshType Thresh, typename T>
+Matrix<T> Image::threshold(const Matrix<T>& mat, std::initializer_list<float> lowerBounds,
+                                                 std::initializer_list<float> upperBounds) {
+  Matrix<T> res;
+  threshold<Thresh>(mat, res, lowerBounds, upperBounds);
 
   return res;
 }
 
 template <typename T>
-Matrix<T> Image::horizontalFlip(const Matrix<T>& mat) {
-  Matrix<T> res(mat.getWidth(), mat.getHeight(), mat.getChannelCount(), mat.getImgBitDepth(), mat.getColorspace());
+Matrix<T> Image::rotateLeft(const Matrix<T>& mat) {
+  return rotateLeft(mat.getView());
+}
+
+template <typename T>
+Matrix<std::remove_const_t<T>> Image::rotateLeft(const MatrixView<T>& mat) {
+  Matrix<std::remove_const_t<T>> res;
+  rotateLeft(mat, res);
+
+  return res;
+}
 
-  for (std::size_t hIndex = 0, resHIndex = 0; hIndex < mat.getHeight(), resHIndex < res.getHeight(); ++hIndex, ++resHIndex) {
-    for (std::size_t wIndex = 0, resWIndex = res.getWidth() - 1; wIndex < mat.getWidth(), resWIndex > 0; ++wIndex, --resWIndex) {
-      const std::size_t matIndex = (hIndex * mat.getWidth() + wIndex) * mat.getChannelCount();
-      const std::size_t resIndex = (resHIndex * res.getWidth() + resWIndex) * res.getChannelCount();
+template <typename T>
+void Image::rotateLeft(const Matrix<T>& mat, Matrix<T>& res) {
+  rotateLeft(mat.getView(), res);
+}
+
+template <typename T>
+void Image::rotateLeft(const MatrixView<T>& mat, Matrix<std::remove_const_t<T>>& res) {
+  res.reshape(mat.getHeight(), mat.getWidth(), mat.getChannelCount(), mat.getImgBitDepth(), mat.getColorspace(), res.hasPaddedRows());
+
+  dispatchChannelCount(mat.getChannelCount(), [&mat, &res] (auto channels) {
+    const uint8_t channelCount = channels(mat.getChannelCount());
 
-      for (uint8_t chan = 0; chan < mat.getChannelCount(); ++chan)
-        res[resIndex + chan] = mat[matIndex + chan];
+    for (std::size_t hIndex = 0; hIndex < mat.getHeight(); ++hIndex) {
+      const T* matPixel = mat.getRow(hIndex);
+
+      for (std::size_t wIndex = 0; wIndex < mat.getWidth(); ++wIndex, matPixel += channelCount) {
+        std::remove_const_t<T>* resPixel = res.getData().data() + (res.getHeight() - 1 - wIndex) * res.getStride() + hIndex * channelCount;
+
+        for (uint8_t chan = 0; chan < channelCount; ++chan)
+          resPixel[chan] = matPixel[chan];
+      }
     }
-  }
+  });
+}
+
+template <typename T>
+Matrix<T> Image::rotateRight(const Matrix<T>& mat) {
+  return rotateRight(mat.getView());
+}
+
+template <typename T>
+Matrix<std::remove_const_t<T>> Image::rotateRight(const MatrixView<T>& mat) {
+  Matrix<std::remove_const_t<T>> res;
+  rotateRight(mat, res);
 
   return res;
 }
 
 template <typename T>
-Matrix<T> Image::verticalFlip(const Matrix<T>& mat) {
-  Matrix<T> res(mat.getWidth(), mat.getHeight(), mat.getChannelCount(), mat.getImgBitDepth(), mat.getColorspace());
+void Image::rotateRight(const Matrix<T>& mat, Matrix<T>& res) {
+  rotateRight(mat.getView(), res);
+}
+
+template <typename T>
+void Image::rotateRight(const MatrixView<T>& mat, Matrix<std::remove_const_t<T>>& res) {
+  res.reshape(mat.getHeight(), mat.getWidth(), mat.getChannelCount(), mat.getImgBitDepth(), mat.getColorspace(), res.hasPaddedRows());
 
-  for (std::size_t hIndex = 0, resHIndex = res.getHeight() - 1; hIndex < mat.getHeight(), resHIndex > 0; ++hIndex, --resHIndex) {
-    for (std::size_t wIndex = 0, resWIndex = 0; wIndex < mat.getWidth(), resWIndex < res.getWidth(); ++wIndex, ++resWIndex) {
-      const std::size_t matIndex = (hIndex * mat.getWidth() + wIndex) * mat.getChannelCount();
-      const std::size_t resIndex = (resHIndex * res.getWidth() + resWIndex) * res.getChannelCount();
+  dispatchChannelCount(mat.getChannelCount(), [&mat, &res] (auto channels) {
+    const uint8_t channelCount = channels(mat.getChannelCount());
 
-      for (uint8_t chan = 0; chan < mat.getChannelCount(); ++chan)
-        res[resIndex + chan] = mat[matIndex + chan];
+    for (std::size_t hIndex = 0; hIndex < mat.getHeight(); ++hIndex) {
+      const T* matPixel = mat.getRow(hIndex);
+
+      for (std::size_t wIndex = 0; wIndex < mat.getWidth(); ++wIndex, matPixel += channelCount) {
+        std::remove_const_t<T>* resPixel = res.getData().data() + wIndex * res.getStride() + (res.getWidth() - 1 - hIndex) * channelCount;
+
+        for (uint8_t chan = 0; chan < channelCount; ++chan)
+          resPixel[chan] = matPixel[chan];
+      }
     }
-  }
+  });
+}
+
+template <typename T>
+Matrix<T> Image::reverse(const Matrix<T>& mat) {
+  return reverse(mat.getView());
+}
+
+template <typename T>
+Matrix<std::remove_const_t<T>> Image::reverse(const MatrixView<T>& mat) {
+  Matrix<std::remove_const_t<T>> res;
+  reverse(mat, res);
 
   return res;
 }
 
 template <typename T>
-Matrix<T> Image::region(const Matrix<T>& mat, std::size_t widthBegin, std::size_t widthEnd,
-                                              std::size_t heightBegin, std::size_t heightEnd) {
-  assert(("Error: Beginning boundaries must be lower than ending ones", widthBegin < widthEnd && heightBegin < heightEnd));
+void Image::reverse(const Matrix<T>& mat, Matrix<T>& res) {
+  reverse(mat.getView(), res);
+}
+
+template <typename T>
+void Image::reverse(const MatrixView<T>& mat, Matrix<std::remove_const_t<T>>& res) {
+  // Reversing is flipping horizontally a vertically flipped view, which costs nothing
+  horizontalFlip(verticalFlip(mat), res);
+}
+
+template <typename T>
+Matrix<T> Image::horizontalFlip(const Matrix<T>& mat) {
+  return horizontalFlip(mat.getView());
+}
+
+template <typename T>
+Matrix<std::remove_const_t<T>> Image::horizontalFlip(const MatrixView<T>& mat) {
+  Matrix<std::remove_const_t<T>> res;
+  horizontalFlip(mat, res);
+
+  return res;
+}
+
+template <typename T>
+void Image::horizontalFlip(const Matrix<T>& mat, Matrix<T>& res) {
+  horizontalFlip(mat.getView(), res);
+}
+
+template <typename T>
+void Image::horizontalFlip(const MatrixView<T>& mat, Matrix<std::remove_const_t<T>>& res) {
+  res.reshape(mat.getWidth(), mat.getHeight(), mat.getChannelCount(), mat.getImgBitDepth(), mat.getColorspace(), res.hasPaddedRows());
 
-  Matrix<T> res(widthEnd - widthBegin, heightEnd - heightBegin, mat.getChannelCount(), mat.getImgBitDepth(), mat.getColorspace());
+  dispatchChannelCount(mat.getChannelCount(), [&mat, &res] (auto channels) {
+    const uint8_t channelCount = channels(mat.getChannelCount());
 
-  for (std::size_t hIndex = heightBegin, resHIndex = 0; hIndex < heightEnd, resHIndex < res.getHeight(); ++hIndex, ++resHIndex) {
-    for (std::size_t wIndex = widthBegin, resWIndex = 0; wIndex < heightEnd, resWIndex < res.getWidth(); ++wIndex, ++resWIndex) {
-      const std::size_t matIndex = (hIndex * mat.getWidth() + wIndex) * mat.getChannelCount();
-      const std::size_t resIndex = (resHIndex * res.getWidth() + resWIndex) * res.getChannelCount();
+    for (std::size_t hIndex = 0; hIndex < mat.getHeight(); ++hIndex) {
+      const T* matPixel = mat.getRow(hIndex);
 
-      for (uint8_t chan = 0; chan < mat.getChannelCount(); ++chan)
-        res[resIndex + chan] = mat[matIndex + chan];
+      for (std::size_t wIndex = 0; wIndex < mat.getWidth(); ++wIndex, matPixel += channelCount) {
+        std::remove_const_t<T>* resPixel = res.getData().data() + hIndex * res.getStride() + (res.getWidth() - 1 - wIndex) * channelCount;
+
+        for (uint8_t chan = 0; chan < channelCount; ++chan)
+          resPixel[chan] = matPixel[chan];
+      }
     }
-  }
+  });
+}
 
-  return res;
+template <typename T>
+Matrix<T> Image::verticalFlip(const Matrix<T>& mat) {
+  return Matrix<T>(verticalFlip(mat.getView()));
+}
+
+template <typename T>
+MatrixView<T> Image::verticalFlip(const MatrixView<T>& mat) {
+  // Empty views have no last row to start from
+  if (mat.getHeight() == 0)
+    return mat;
+
+  // Starting from the last row & walking backwards
+  return MatrixView<T>(mat.getRow(mat.getHeight() - 1),
+                       mat.getWidth(),
+                       mat.getHeight(),
+                       mat.getChannelCount(),
+                       -mat.getRowStride(),
+                       mat.getImgBitDepth(),
+                       mat.getColorspace());
+}
+
+template <typename T>
+void Image::verticalFlip(const Matrix<T>& mat, Matrix<T>& res) {
+  res.copyFrom(verticalFlip(mat.getView()));
+}
+
+template <typename T>
+Matrix<T> Image::region(const Matrix<T>& mat, std::size_t widthBegin, std::size_t widthEnd,
+                                              std::size_t heightBegin, std::size_t heightEnd) {
+  return Matrix<T>(region(mat.getView(), widthBegin, widthEnd, heightBegin, heightEnd));
+}
+
+template <typename T>
+MatrixView<T> Image::region(const MatrixView<T>& mat, std::size_t widthBegin, std::size_t widthEnd,
+                                                      std::size_t heightBegin, std::size_t heightEnd) {
+  return mat.subView(widthBegin, widthEnd, heightBegin, heightEnd);
+}
+
+template <typename T>
+void Image::region(const Matrix<T>& mat, Matrix<T>& res, std::size_t widthBegin, std::size_t widthEnd,
+                                                         std::size_t heightBegin, std::size_t heightEnd) {
+  res.copyFrom(region(mat.getView(), widthBegin, widthEnd, heightBegin, heightEnd));
 }
 
 } // namespace Arcv
@@ -7,25 +7,39 @@
 
 namespace Arcv {
 
+// Gradients of integer images are stored as int16_t, which int16_t ones fill entirely from 13-bit values onwards;
+//  those of floating point images stay as floats
+template <typename T> struct SobelGradient { using Type = float; };
+template <> struct SobelGradient<uint8_t> { using Type = int16_t; };
+template <> struct SobelGradient<int16_t> { using Type = int16_t; };
+
+template <typename T = float>
 class Sobel {
 public:
-  Sobel(const Matrix<>& mat);
-
-  const Matrix<>& getSobelMat() const { return sobelMat; }
-  Matrix<>& getSobelMat() { return sobelMat; }
-  const Matrix<>& getHorizontalGradient() const { return horizontalGradient; }
-  Matrix<>& getHorizontalGradient() { return horizontalGradient; }
-  const Matrix<>& getVerticalGradient() const { return verticalGradient; }
-  Matrix<>& getVerticalGradient() { return verticalGradient; }
-
-  static Matrix<> computeHorizontalSobelOperator(const Matrix<>& mat);
-  static Matrix<> computeVerticalSobelOperator(const Matrix<>& mat);
-  Matrix<> computeGradientDirection() const;
+  using GradientType = typename SobelGradient<T>::Type;
+
+  // Gradients are allocated through the given allocator, which can draw from a memory arena
+  Sobel(const MatrixView<const T>& mat, const AlignedAllocator<GradientType>& allocator = AlignedAllocator<GradientType>());
+
+  const Matrix<GradientType>& getSobelMat() const { return sobelMat; }
+  Matrix<GradientType>& getSobelMat() { return sobelMat; }
+  const Matrix<GradientType>& getHorizontalGradient() const { return horizontalGradient; }
+  Matrix<GradientType>& getHorizontalGradient() { return horizontalGradient; }
+  const Matrix<GradientType>& getVerticalGradient() const { return verticalGradient; }
+  Matrix<GradientType>& getVerticalGradient() { return verticalGradient; }
+
+  static Matrix<GradientType> computeHorizontalSobelOperator(const MatrixView<const T>& mat);
+  static void computeHorizontalSobelOperator(const MatrixView<const T>& mat, Matrix<GradientType>& res);
+  static Matrix<GradientType> computeVerticalSobelOperator(const MatrixView<const T>& mat);
+  static void computeVerticalSobelOperator(const MatrixView<const T>& mat, Matrix<GradientType>& res);
+  // Directions are given in degrees, in the [0; 360] range
+  Matrix<float> computeGradientDirection() const;
+  void computeGradientDirection(Matrix<float>& res) const;
 
 private:
-  Matrix<> sobelMat;
-  Matrix<> horizontalGradient;
-  Matrix<> verticalGradient;
+  Matrix<GradientType> sobelMat;
+  Matrix<GradientType> horizontalGradient;
+  Matrix<GradientType> verticalGradient;
 };
 
 } // namespace Arcv
@@ -0,0 +1,35 @@
+#pragma once
+
+#ifndef ARCV_SCRATCHBUFFER_HPP
+#define ARCV_SCRATCHBUFFER_HPP
+
+#include <vector>
+#include <cstddef>
+
+#include "ArcV/Math/AlignedAllocator.hpp"
+
+namespace Arcv {
+
+// Gives an aligned buffer kept by the calling thread from a call to the next, so that kernels run repeatedly on the
+//  thread pool only allocate while warming up; each Tag designates its own buffer, whose content is left as is but may
+//  be lost on the next request of the same Tag & type by the same thread
+template <typename Tag, typename T>
+std::vector<T, AlignedAllocator<T>>& getScratchVector() {
+  thread_local std::vector<T, AlignedAllocator<T>> buffer;
+  return buffer;
+}
+
+// Gives at least count elements of the calling thread's buffer designated by Tag
+template <typename Tag, typename T>
+T* getScratchBuffer(std::size_t count) {
+  std::vector<T, AlignedAllocator<T>>& buffer = getScratchVector<Tag, T>();
+
+  if (buffer.size() < count)
+    buffer.resize(count);
+
+  return buffer.data();
+}
+
+} // namespace Arcv
+
+#endif // ARCV_SCRATCHBUFFER_HPP
@@ -0,0 +1,45 @@
+#pragma once
+
+#ifndef ARCV_THREADPOOL_HPP
+#define ARCV_THREADPOOL_HPP
+
+#include <queue>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+
+namespace Arcv {
+
+class ThreadPool {
+public:
+  // The calling thread always takes part in the work, hence one worker less than available hardware threads
+  explicit ThreadPool(std::size_t threadCount = std::thread::hardware_concurrency());
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  static ThreadPool& getInstance();
+  std::size_t getThreadCount() const { return workers.size() + 1; }
+
+  // Calls function(begin, end) on contiguous ranges of [0, count) concurrently, returning once all of them are
+  //  processed; ranges are processed sequentially if called from within a worker
+  void parallelFor(std::size_t count, const std::function<void(std::size_t, std::size_t)>& function);
+
+  ~ThreadPool();
+
+private:
+  void processTasks();
+
+  static thread_local bool isWorker;
+
+  std::vector<std::thread> workers;
+  std::queue<std::function<void()>> tasks;
+  std::mutex tasksMutex;
+  std::condition_variable tasksCondition;
+  bool stopping = false;
+};
+
+} // namespace Arcv
+
+#endif // ARCV_THREADPOOL_HPP
@@ -0,0 +1,65 @@
+#include <algorithm>
+
+#include "ArcV/Math/BitMatrix.hpp"
+#include "ArcV/Utils/ThreadPool.hpp"
+
+namespace Arcv {
+
+constexpr std::size_t BitMatrix::WordBitCount;
+
+void BitMatrix::reshape(std::size_t width, std::size_t height) {
+  this->width = width;
+  this->height = height;
+  rowWordCount = (width + WordBitCount - 1) / WordBitCount;
+
+  data.assign(rowWordCount * height, 0);
+}
+
+template <typename T>
+void BitMatrix::pack(const MatrixView<const T>& mat) {
+  assert(("Error: Bit matrices can only be packed from single-channel matrices", mat.getChannelCount() == 1));
+
+  reshape(mat.getWidth(), mat.getHeight());
+
+  ThreadPool::getInstance().parallelFor(height, [&] (std::size_t begin, std::size_t end) {
+    for (std::size_t heightIndex = begin; heightIndex < end; ++heightIndex) {
+      const T* row = mat.getRow(heightIndex);
+      uint64_t* bitRow = getRow(heightIndex);
+
+      for (std::size_t wordIndex = 0; wordIndex < rowWordCount; ++wordIndex) {
+        const T* elements = row + wordIndex * WordBitCount;
+        const std::size_t elementCount = std::min(WordBitCount, width - wordIndex * WordBitCount);
+        uint64_t word = 0;
+
+        for (std::size_t bitIndex = 0; bitIndex < elementCount; ++bitIndex)
+          word |= uint64_t(elements[bitIndex] != 0) << bitIndex;
+
+        bitRow[wordIndex] = word;
+      }
+    }
+  });
+}
+
+template <typename T>
+void BitMatrix::unpack(Matrix<T>& res) const {
+  res.reshape(width, height, 1, 8, ARCV_COLORSPACE_GRAY, res.hasPaddedRows());
+
+  ThreadPool::getInstance().parallelFor(height, [&] (std::size_t begin, std::size_t end) {
+    for (std::size_t heightIndex = begin; heightIndex < end; ++heightIndex) {
+      const uint64_t* bitRow = getRow(heightIndex);
+      T* resRow = res.getData().data() + heightIndex * res.getStride();
+
+      for (std::size_t widthIndex = 0; widthIndex < width; ++widthIndex)
+        resRow[widthIndex] = ((bitRow[widthIndex / WordBitCount] >> (widthIndex % WordBitCount)) & 1 ? 255 : 0);
+    }
+  });
+}
+
+template void BitMatrix::pack(const MatrixView<const float>& mat);
+template void BitMatrix::pack(const MatrixView<const uint8_t>& mat);
+template void BitMatrix::pack(const MatrixView<const int16_t>& mat);
+template void BitMatrix::unpack(Matrix<float>& res) const;
+template void BitMatrix::unpack(Matrix<uint8_t>& res) const;
+template void BitMatrix::unpack(Matrix<int16_t>& res) const;
+
+} // namespace Arcv
@@ -0,0 +1,277 @@
+#ifdef _WIN32
+#define _USE_MATH_DEFINES
+#endif
+
+#include <map>
+#include <cmath>
+#include <mutex>
+#include <memory>
+#include <cassert>
+#include <algorithm>
+
+#include "ArcV/Math/Fft.hpp"
+#include "ArcV/Math/Simd.hpp"
+#include "ArcV/Utils/ThreadPool.hpp"
+
+namespace Arcv {
+
+namespace Fft {
+
+namespace {
+
+// std::complex's multiplication handles infinities & NaNs through a library call, which the plain formula avoids
+inline std::complex<float> multiply(std::complex<float> lhs, std::complex<float> rhs) {
+  return { lhs.real() * rhs.real() - lhs.imag() * rhs.imag(), lhs.real() * rhs.imag() + lhs.imag() * rhs.real() };
+}
+
+// Sequences are transformed by blocks, whose values at a given index are processed together by vectors; blocks of columns are
+//  transformed in place, rows being transposed into blocks first, which also packs them for real transforms
+constexpr std::size_t BlockSize = 32;
+
+void transformColumns(std::complex<float>* data, std::size_t width, std::size_t height, FftDirection direction) {
+  const Plan& plan = getPlan(height);
+  const std::size_t blockCount = (width + BlockSize - 1) / BlockSize;
+
+  ThreadPool::getInstance().parallelFor(blockCount, [&] (std::size_t blockBegin, std::size_t blockEnd) {
+    for (std::size_t blockIndex = blockBegin; blockIndex < blockEnd; ++blockIndex) {
+      const std::size_t columnBegin = blockIndex * BlockSize;
+      plan.transform(data + columnBegin, width, std::min(BlockSize, width - columnBegin), direction);
+    }
+  });
+}
+
+} // namespace
+
+// Twiddles are computed in double precision & independently from each other, accumulating no rounding error
+Plan::Plan(std::size_t size) : size{ size }, bitReversedIndices(size), twiddles(size - 1), inverseTwiddles(size - 1),
+                                       realTwiddles(size / 2 + 1) {
+  assert(("Error: FFT size must be a power of 2", size > 0 && (size & (size - 1)) == 0));
+
+  uint8_t bitCount = 0;
+  while ((std::size_t(1) << bitCount) < size)
+    ++bitCount;
+
+  for (std::size_t index = 0; index < size; ++index) {
+    uint32_t reversedIndex = 0;
+
+    for (uint8_t bitIndex = 0; bitIndex < bitCount; ++bitIndex)
+      reversedIndex |= ((index >> bitIndex) & 1) << (bitCount - 1 - bitIndex);
+
+    bitReversedIndices[index] = reversedIndex;
+  }
+
+  // Each stage's twiddles follow the previous ones', those of butterflies spanning 2 * halfLength values starting at
+  //  index halfLength - 1
+  for (std::size_t halfLength = 1; halfLength < size; halfLength *= 2) {
+    for (std::size_t twiddleIndex = 0; twiddleIndex < halfLength; ++twiddleIndex)
+      twiddles[halfLength - 1 + twiddleIndex] = std::polar(1.0, -M_PI * twiddleIndex / halfLength);
+  }
+
+  std::transform(twiddles.cbegin(), twiddles.cend(), inverseTwiddles.begin(), [] (std::complex<float> twiddle) {
+    return std::conj(twiddle);
+  });
+
+  for (std::size_t twiddleIndex = 0; twiddleIndex < realTwiddles.size(); ++twiddleIndex)
+    realTwiddles[twiddleIndex] = std::polar(1.0, -M_PI * twiddleIndex / size);
+}
+
+// Iterative radix-2 decimation in time: values are put in bit-reversed order, then combined by butterflies of
+//  increasing spans; inverse transforms only differ by their conjugated twiddles
+void Plan::transform(std::complex<float>* data, std::size_t rowStride, std::size_t batchSize, FftDirection direction) const {
+  for (std::size_t index = 0; index < size; ++index) {
+    const std::size_t reversedIndex = bitReversedIndices[index];
+
+    if (index < reversedIndex)
+      std::swap_ranges(data + index * rowStride, data + index * rowStride + batchSize, data + reversedIndex * rowStride);
+  }
+
+  const std::vector<std::complex<float>>& stagesTwiddles = (direction == ARCV_FFT_DIRECTION_INVERSE ? inverseTwiddles : twiddles);
+
+  for (std::size_t halfLength = 1; halfLength < size; halfLength *= 2) {
+    Simd::computeFftStage(reinterpret_cast<float*>(data), size, rowStride, batchSize, halfLength,
+                          reinterpret_cast<const float*>(stagesTwiddles.data() + halfLength - 1));
+  }
+}
+
+void Plan::transformReal(const float* input, std::complex<float>* output) const {
+  for (std::size_t index = 0; index < size; ++index)
+    output[index] = { input[2 * index], input[2 * index + 1] };
+
+  transformPackedReal(output, 1);
+}
+
+void Plan::inverseTransformReal(std::complex<float>* input, float* output) const {
+  inverseTransformPackedReal(input, 1);
+
+  for (std::size_t index = 0; index < size; ++index) {
+    output[2 * index] = input[index].real();
+    output[2 * index + 1] = input[index].imag();
+  }
+}
+
+// Even & odd values are transformed at once as the real & imaginary parts of complex ones; their spectra E & O are then
+//  told apart by symmetry & recombined as X[k] = E[k] + exp(-2i * pi * k / (2 * size)) * O[k]
+void Plan::transformPackedReal(std::complex<float>* data, std::size_t batchSize) const {
+  transform(data, batchSize, batchSize, ARCV_FFT_DIRECTION_FORWARD);
+
+  std::complex<float>* lastValues = data + size * batchSize;
+
+  for (std::size_t batchIndex = 0; batchIndex < batchSize; ++batchIndex) {
+    const std::complex<float> first = data[batchIndex];
+    data[batchIndex] = first.real() + first.imag();
+    lastValues[batchIndex] = first.real() - first.imag();
+  }
+
+  // X[size - k] is given by the same E[k] & O[k] as X[k], both being computed together
+  for (std::size_t index = 1; index <= size / 2; ++index) {
+    std::complex<float>* values = data + index * batchSize;
+    std::complex<float>* mirroredValues = data + (size - index) * batchSize;
+    const std::complex<float> realTwiddle = realTwiddles[index];
+
+    for (std::size_t batchIndex = 0; batchIndex < batchSize; ++batchIndex) {
+      const std::complex<float> value = values[batchIndex];
+      const std::complex<float> mirroredValue = std::conj(mirroredValues[batchIndex]);
+
+      const std::complex<float> evenValue = (value + mirroredValue) * 0.5f;
+      const std::complex<float> oddValue = multiply(value - mirroredValue, { 0.f, -0.5f });
+      const std::complex<float> twiddledOddValue = multiply(realTwiddle, oddValue);
+
+      values[batchIndex] = evenValue + twiddledOddValue;
+      mirroredValues[batchIndex] = std::conj(evenValue - twiddledOddValue);
+    }
+  }
+}
+
+// Reverses transformPackedReal()'s recombination, the halves' spectra being left doubled rather than halved
+void Plan::inverseTransformPackedReal(std::complex<float>* data, std::size_t batchSize) const {
+  const std::complex<float>* lastValues = data + size * batchSize;
+
+  for (std::size_t batchIndex = 0; batchIndex < batchSize; ++batchIndex) {
+    const float first = data[batchIndex].real();
+    const float last = lastValues[batchIndex].real();
+    data[batchIndex] = { first + last, first - last };
+  }
+
+  for (std::size_t index = 1; index <= size / 2; ++index) {
+    std::complex<float>* values = data + index * batchSize;
+    std::complex<float>* mirroredValues = data + (size - index) * batchSize;
+    const std::complex<float> realTwiddle = std::conj(realTwiddles[index]);
+
+    for (std::size_t batchIndex = 0; batchIndex < batchSize; ++batchIndex) {
+      const std::complex<float> value = values[batchIndex];
+      const std::complex<float> mirroredValue = std::conj(mirroredValues[batchIndex]);
+
+      const std::complex<float> evenValue = value + mirroredValue;
+      const std::complex<float> oddValue = multiply(value - mirroredValue, realTwiddle);
+
+      values[batchIndex] = { evenValue.real() - oddValue.imag(), evenValue.imag() + oddValue.real() };
+      mirroredValues[batchIndex] = { evenValue.real() + oddValue.imag(), oddValue.real() - evenValue.imag() };
+    }
+  }
+
+  transform(data, batchSize, batchSize, ARCV_FFT_DIRECTION_INVERSE);
+}
+
+std::size_t computeTransformSize(std::size_t size) {
+  std::size_t transformSize = 1;
+  while (transformSize < size)
+    transformSize *= 2;
+
+  return transformSize;
+}
+
+const Plan& getPlan(std::size_t size) {
+  static std::mutex plansMutex;
+  static std::map<std::size_t, std::unique_ptr<Plan>> plans;
+
+  std::lock_guard<std::mutex> lock(plansMutex);
+  std::unique_ptr<Plan>& plan = plans[size];
+
+  if (!plan)
+    plan = std::make_unique<Plan>(size);
+
+  return *plan;
+}
+
+void transformReal2D(const float* input, std::size_t inputStride, std::size_t width, std::size_t height,
+                     std::complex<float>* output) {
+  assert(("Error: Real 2D transforms must be at least 2 values wide", width >= 2));
+
+  const Plan& rowPlan = getPlan(width / 2);
+  const std::size_t spectrumWidth = width / 2 + 1;
+  const std::size_t blockCount = (height + BlockSize - 1) / BlockSize;
+
+  ThreadPool::getInstance().parallelFor(blockCount, [&] (std::size_t blockBegin, std::size_t blockEnd) {
+    std::vector<std::complex<float>> block(spectrumWidth * BlockSize);
+
+    for (std::size_t blockIndex = blockBegin; blockIndex < blockEnd; ++blockIndex) {
+      const std::size_t rowBegin = blockIndex * BlockSize;
+      const std::size_t blockHeight = std::min(BlockSize, height - rowBegin);
+
+      for (std::size_t rowIndex = 0; rowIndex < blockHeight; ++rowIndex) {
+        const float* inputRow = input + (rowBegin + rowIndex) * inputStride;
+
+        for (std::size_t index = 0; index < width / 2; ++index)
+          block[index * blockHeight + rowIndex] = { inputRow[2 * index], inputRow[2 * index + 1] };
+      }
+
+      rowPlan.transformPackedReal(block.data(), blockHeight);
+
+      for (std::size_t rowIndex = 0; rowIndex < blockHeight; ++rowIndex) {
+        std::complex<float>* outputRow = output + (rowBegin + rowIndex) * spectrumWidth;
+
+        for (std::size_t index = 0; index < spectrumWidth; ++index)
+          outputRow[index] = block[index * blockHeight + rowIndex];
+      }
+    }
+  });
+
+  transformColumns(output, spectrumWidth, height, ARCV_FFT_DIRECTION_FORWARD);
+}
+
+void inverseTransformReal2D(std::complex<float>* input, std::size_t width, std::size_t height, float* output,
+                            std::size_t outputStride) {
+  assert(("Error: Real 2D transforms must be at least 2 values wide", width >= 2));
+
+  const Plan& rowPlan = getPlan(width / 2);
+  const std::size_t spectrumWidth = width / 2 + 1;
+  const std::size_t blockCount = (height + BlockSize - 1) / BlockSize;
+
+  transformColumns(input, spectrumWidth, height, ARCV_FFT_DIRECTION_INVERSE);
+
+  ThreadPool::getInstance().parallelFor(blockCount, [&] (std::size_t blockBegin, std::size_t blockEnd) {
+    std::vector<std::complex<float>> block(spectrumWidth * BlockSize);
+
+    for (std::size_t blockIndex = blockBegin; blockIndex < blockEnd; ++blockIndex) {
+      const std::size_t rowBegin = blockIndex * BlockSize;
+      const std::size_t blockHeight = std::min(BlockSize, height - rowBegin);
+
+      for (std::size_t rowIndex = 0; rowIndex < blockHeight; ++rowIndex) {
+        const std::complex<float>* inputRow = input + (rowBegin + rowIndex) * spectrumWidth;
+
+        for (std::size_t index = 0; index < spectrumWidth; ++index)
+          block[index * blockHeight + rowIndex] = inputRow[index];
+      }
+
+      rowPlan.inverseTransformPackedReal(block.data(), blockHeight);
+
+      for (std::size_t rowIndex = 0; rowIndex < blockHeight; ++rowIndex) {
+        float* outputRow = output + (rowBegin + rowIndex) * outputStride;
+
+        for (std::size_t index = 0; index < width / 2; ++index) {
+          outputRow[2 * index] = block[index * blockHeight + rowIndex].real();
+          outputRow[2 * index + 1] = block[index * blockHeight + rowIndex].imag();
+        }
+      }
+    }
+  });
+}
+
+void multiplySpectra(std::complex<float>* spectrum, const std::complex<float>* factors, std::size_t count) {
+  for (std::size_t index = 0; index < count; ++index)
+    spectrum[index] = multiply(spectrum[index], factors[index]);
+}
+
+} // namespace Fft
+
+} // namespace Arcv
@@ -0,0 +1,46 @@
+#include <algorithm>
+
+#include "ArcV/Math/MemoryArena.hpp"
+
+namespace Arcv {
+
+thread_local MemoryArena* MemoryArena::currentArena = nullptr;
+
+void* MemoryArena::allocate(std::size_t byteCount, std::size_t alignment) {
+  while (chunkIndex < chunks.size()) {
+    const std::uintptr_t chunkBegin = reinterpret_cast<std::uintptr_t>(chunks[chunkIndex].memory.get());
+    const std::uintptr_t alignedAddress = (chunkBegin + chunkOffset + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+    const std::size_t alignedOffset = alignedAddress - chunkBegin;
+
+    if (alignedOffset + byteCount <= chunks[chunkIndex].size) {
+      chunkOffset = alignedOffset + byteCount;
+      usedMemory += byteCount;
+
+      return reinterpret_cast<void*>(alignedAddress);
+    }
+
+    ++chunkIndex;
+    chunkOffset = 0;
+  }
+
+  // No chunk left is large enough, a new one being added
+  const std::size_t newChunkSize = std::max(chunkSize, byteCount + alignment);
+  chunks.push_back({ std::unique_ptr<uint8_t[]>(new uint8_t[newChunkSize]), newChunkSize });
+  reservedMemory += newChunkSize;
+
+  return allocate(byteCount, alignment);
+}
+
+void MemoryArena::reset() {
+  // Merging chunks when several were needed, so that the next frame fits in a single one
+  if (chunks.size() > 1) {
+    chunks.clear();
+    chunks.push_back({ std::unique_ptr<uint8_t[]>(new uint8_t[reservedMemory]), reservedMemory });
+  }
+
+  chunkIndex = 0;
+  chunkOffset = 0;
+  usedMemory = 0;
+}
+
+} // namespace Arcv
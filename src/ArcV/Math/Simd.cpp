@@ -0,0 +1,1694 @@
+#include <limits>
+#include <cassert>
+#include <algorithm>
+#include <type_traits>
+
+#include "ArcV/Math/SimdVector.hpp"
+
+namespace Arcv {
+
+namespace Simd {
+
+namespace {
+
+SimdInstructionSet detectInstructionSet() {
+#ifdef ARCV_SIMD_X86
+  __builtin_cpu_init();
+
+  // Byte operations need AVX-512BW on top of the foundation
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+    return ARCV_SIMD_AVX512;
+  if (__builtin_cpu_supports("avx2"))
+    return ARCV_SIMD_AVX2;
+  if (__builtin_cpu_supports("sse2"))
+    return ARCV_SIMD_SSE2;
+#endif
+
+  return ARCV_SIMD_NONE;
+}
+
+SimdInstructionSet getSupportedInstructionSet() {
+  static const SimdInstructionSet supportedInstructionSet = detectInstructionSet();
+  return supportedInstructionSet;
+}
+
+SimdInstructionSet& getCurrentInstructionSet() {
+  static SimdInstructionSet currentInstructionSet = getSupportedInstructionSet();
+  return currentInstructionSet;
+}
+
+// Butterflies between the batchSize values of two rows of complex values; the twiddle's product is computed as in
+//  vectorized kernels, (re * twRe + im * -twIm, im * twRe + re * twIm), to give the very same results
+void computeButterfliesReference(float* evenValues, float* oddValues, std::size_t batchSize, float twiddleReal, float twiddleImag) {
+  for (std::size_t valueIndex = 0; valueIndex < batchSize; ++valueIndex) {
+    const float oddReal = oddValues[2 * valueIndex];
+    const float oddImag = oddValues[2 * valueIndex + 1];
+    const float productReal = oddReal * twiddleReal + oddImag * -twiddleImag;
+    const float productImag = oddImag * twiddleReal + oddReal * twiddleImag;
+
+    oddValues[2 * valueIndex] = evenValues[2 * valueIndex] - productReal;
+    oddValues[2 * valueIndex + 1] = evenValues[2 * valueIndex + 1] - productImag;
+    evenValues[2 * valueIndex] += productReal;
+    evenValues[2 * valueIndex + 1] += productImag;
+  }
+}
+
+// Calls computeButterflies(evenValues, oddValues, twiddleReal, twiddleImag) on every pair of rows of an FFT stage
+template <typename Func>
+void forEachButterflyRows(float* data, std::size_t sequenceSize, std::size_t rowStride, std::size_t halfLength,
+                          const float* twiddles, Func&& computeButterflies) {
+  for (std::size_t spanBegin = 0; spanBegin < sequenceSize; spanBegin += 2 * halfLength) {
+    for (std::size_t valueIndex = 0; valueIndex < halfLength; ++valueIndex) {
+      float* evenValues = data + 2 * (spanBegin + valueIndex) * rowStride;
+      computeButterflies(evenValues, evenValues + 2 * halfLength * rowStride, twiddles[2 * valueIndex], twiddles[2 * valueIndex + 1]);
+    }
+  }
+}
+
+// Median networks of 9 & 25 values, taken from Devillard's "Fast median search" & checked on every sequence of 0s & 1s;
+//  they only keep the compare-exchanges on which the middle value depends
+constexpr uint8_t median9Pairs[][2] = {
+  {1, 2}, {4, 5}, {7, 8}, {0, 1}, {3, 4}, {6, 7}, {1, 2}, {4, 5}, {7, 8}, {0, 3}, {5, 8}, {4, 7}, {3, 6}, {1, 4},
+  {2, 5}, {4, 7}, {4, 2}, {6, 4}, {4, 2}
+};
+
+constexpr uint8_t median25Pairs[][2] = {
+  {0, 1}, {3, 4}, {2, 4}, {2, 3}, {6, 7}, {5, 7}, {5, 6}, {9, 10}, {8, 10}, {8, 9}, {12, 13}, {11, 13}, {11, 12},
+  {15, 16}, {14, 16}, {14, 15}, {18, 19}, {17, 19}, {17, 18}, {21, 22}, {20, 22}, {20, 21}, {23, 24}, {2, 5}, {3, 6},
+  {0, 6}, {0, 3}, {4, 7}, {1, 7}, {1, 4}, {11, 14}, {8, 14}, {8, 11}, {12, 15}, {9, 15}, {9, 12}, {13, 16}, {10, 16},
+  {10, 13}, {20, 23}, {17, 23}, {17, 20}, {21, 24}, {18, 24}, {18, 21}, {19, 22}, {8, 17}, {9, 18}, {0, 18}, {0, 9},
+  {10, 19}, {1, 19}, {1, 10}, {11, 20}, {2, 20}, {2, 11}, {12, 21}, {3, 21}, {3, 12}, {13, 22}, {4, 22}, {4, 13},
+  {14, 23}, {5, 23}, {5, 14}, {15, 24}, {6, 24}, {6, 15}, {7, 16}, {7, 19}, {13, 21}, {15, 23}, {7, 13}, {7, 15},
+  {1, 9}, {3, 11}, {5, 17}, {11, 17}, {9, 17}, {4, 10}, {6, 12}, {7, 14}, {4, 6}, {4, 7}, {12, 14}, {10, 14}, {6, 7},
+  {10, 12}, {6, 10}, {6, 17}, {12, 17}, {7, 17}, {7, 10}, {12, 18}, {7, 12}, {10, 18}, {12, 20}, {10, 20}, {10, 12}
+};
+
+template <bool IsMaximum, typename T>
+void computeExtremaReference(const T* lhs, const T* rhs, T* res, std::size_t count) {
+  if (IsMaximum)
+    computeMaximumsReference(lhs, rhs, res, count);
+  else
+    computeMinimumsReference(lhs, rhs, res, count);
+}
+
+#ifdef ARCV_SIMD_X86
+
+template <ElementwiseOperation Op> using OperationTag = std::integral_constant<ElementwiseOperation, Op>;
+
+///////////
+// SSE2 //
+/////////
+
+ARCV_TARGET_SSE2 inline __m128 computeVector(__m128 lhs, __m128 rhs, OperationTag<ARCV_ELEMENTWISE_ADD>) { return _mm_add_ps(lhs, rhs); }
+ARCV_TARGET_SSE2 inline __m128 computeVector(__m128 lhs, __m128 rhs, OperationTag<ARCV_ELEMENTWISE_SUB>) { return _mm_sub_ps(lhs, rhs); }
+ARCV_TARGET_SSE2 inline __m128 computeVector(__m128 lhs, __m128 rhs, OperationTag<ARCV_ELEMENTWISE_MUL>) { return _mm_mul_ps(lhs, rhs); }
+ARCV_TARGET_SSE2 inline __m128 computeVector(__m128 lhs, __m128 rhs, OperationTag<ARCV_ELEMENTWISE_DIV>) { return _mm_div_ps(lhs, rhs); }
+
+ARCV_TARGET_SSE2 inline void widenBytes(__m128i bytes, __m128 (&floats)[4]) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i lowWords = _mm_unpacklo_epi8(bytes, zero);
+  const __m128i highWords = _mm_unpackhi_epi8(bytes, zero);
+
+  floats[0] = _mm_cvtepi32_ps(_mm_unpacklo_epi16(lowWords, zero));
+  floats[1] = _mm_cvtepi32_ps(_mm_unpackhi_epi16(lowWords, zero));
+  floats[2] = _mm_cvtepi32_ps(_mm_unpacklo_epi16(highWords, zero));
+  floats[3] = _mm_cvtepi32_ps(_mm_unpackhi_epi16(highWords, zero));
+}
+
+// Clamping before converting, since out of range values would give 0x80000000; packing reverses the unpacking
+ARCV_TARGET_SSE2 inline __m128i narrowFloats(const __m128 (&floats)[4]) {
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 maxVal = _mm_set1_ps(255.f);
+  __m128i ints[4];
+
+  for (uint8_t i = 0; i < 4; ++i)
+    ints[i] = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(floats[i], zero), maxVal));
+
+  return _mm_packus_epi16(_mm_packs_epi32(ints[0], ints[1]), _mm_packs_epi32(ints[2], ints[3]));
+}
+
+ARCV_TARGET_SSE2 inline __m128i computeBytes(__m128i lhs, __m128i rhs, OperationTag<ARCV_ELEMENTWISE_ADD>) { return _mm_adds_epu8(lhs, rhs); }
+ARCV_TARGET_SSE2 inline __m128i computeBytes(__m128i lhs, __m128i rhs, OperationTag<ARCV_ELEMENTWISE_SUB>) { return _mm_subs_epu8(lhs, rhs); }
+
+template <ElementwiseOperation Op>
+ARCV_TARGET_SSE2 inline __m128i computeBytes(__m128i lhs, __m128i rhs, OperationTag<Op> tag) {
+  __m128 lhsFloats[4], rhsFloats[4];
+  widenBytes(lhs, lhsFloats);
+  widenBytes(rhs, rhsFloats);
+
+  for (uint8_t i = 0; i < 4; ++i)
+    lhsFloats[i] = computeVector(lhsFloats[i], rhsFloats[i], tag);
+
+  return narrowFloats(lhsFloats);
+}
+
+template <ElementwiseOperation Op>
+ARCV_TARGET_SSE2 void applySse2(float* lhs, const float* rhs, std::size_t count) {
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4)
+    _mm_storeu_ps(lhs + i, computeVector(_mm_loadu_ps(lhs + i), _mm_loadu_ps(rhs + i), OperationTag<Op>()));
+
+  applyElementwiseReference<Op>(lhs + i, rhs + i, count - i);
+}
+
+template <ElementwiseOperation Op>
+ARCV_TARGET_SSE2 void applySse2(float* lhs, float val, std::size_t count) {
+  const __m128 rhs = _mm_set1_ps(val);
+
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4)
+    _mm_storeu_ps(lhs + i, computeVector(_mm_loadu_ps(lhs + i), rhs, OperationTag<Op>()));
+
+  applyElementwiseReference<Op>(lhs + i, val, count - i);
+}
+
+template <ElementwiseOperation Op>
+ARCV_TARGET_SSE2 void applySse2(uint8_t* lhs, const uint8_t* rhs, std::size_t count) {
+  std::size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    const __m128i lhsBytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i));
+    const __m128i rhsBytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lhs + i), computeBytes(lhsBytes, rhsBytes, OperationTag<Op>()));
+  }
+
+  applyElementwiseReference<Op>(lhs + i, rhs + i, count - i);
+}
+
+template <ElementwiseOperation Op>
+ARCV_TARGET_SSE2 void applySse2(uint8_t* lhs, float val, std::size_t count) {
+  const __m128 rhs = _mm_set1_ps(val);
+
+  std::size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m128 floats[4];
+    widenBytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i)), floats);
+
+    for (uint8_t floatIndex = 0; floatIndex < 4; ++floatIndex)
+      floats[floatIndex] = computeVector(floats[floatIndex], rhs, OperationTag<Op>());
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lhs + i), narrowFloats(floats));
+  }
+
+  applyElementwiseReference<Op>(lhs + i, val, count - i);
+}
+
+ARCV_TARGET_SSE2 inline void loadFloats(const uint8_t* input, __m128 (&floats)[4]) {
+  widenBytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input)), floats);
+}
+
+// Interleaving words with themselves & shifting them back to the right extends their sign
+ARCV_TARGET_SSE2 inline void loadFloats(const int16_t* input, __m128 (&floats)[4]) {
+  for (uint8_t i = 0; i < 2; ++i) {
+    const __m128i words = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i * 8));
+
+    floats[i * 2] = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(words, words), 16));
+    floats[i * 2 + 1] = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(words, words), 16));
+  }
+}
+
+ARCV_TARGET_SSE2 inline void loadFloats(const float* input, __m128 (&floats)[4]) {
+  for (uint8_t i = 0; i < 4; ++i)
+    floats[i] = _mm_loadu_ps(input + i * 4);
+}
+
+ARCV_TARGET_SSE2 inline void storeFloats(const __m128 (&floats)[4], uint8_t* output) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(output), narrowFloats(floats));
+}
+
+ARCV_TARGET_SSE2 inline void storeFloats(const __m128 (&floats)[4], int16_t* output) {
+  const __m128 minVal = _mm_set1_ps(-32768.f);
+  const __m128 maxVal = _mm_set1_ps(32767.f);
+  __m128i ints[4];
+
+  for (uint8_t i = 0; i < 4; ++i)
+    ints[i] = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(floats[i], minVal), maxVal));
+
+  for (uint8_t i = 0; i < 2; ++i)
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i * 8), _mm_packs_epi32(ints[i * 2], ints[i * 2 + 1]));
+}
+
+ARCV_TARGET_SSE2 inline void storeFloats(const __m128 (&floats)[4], float* output) {
+  for (uint8_t i = 0; i < 4; ++i)
+    _mm_storeu_ps(output + i * 4, floats[i]);
+}
+
+template <typename TI, typename TO>
+ARCV_TARGET_SSE2 void convertSse2(const TI* input, TO* output, std::size_t count, float scale, float offset) {
+  const __m128 scaleVec = _mm_set1_ps(scale);
+  const __m128 offsetVec = _mm_set1_ps(offset);
+
+  std::size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m128 floats[4];
+    loadFloats(input + i, floats);
+
+    for (uint8_t floatIndex = 0; floatIndex < 4; ++floatIndex)
+      floats[floatIndex] = _mm_add_ps(_mm_mul_ps(floats[floatIndex], scaleVec), offsetVec);
+
+    storeFloats(floats, output + i);
+  }
+
+  convertReference(input + i, output + i, count - i, scale, offset);
+}
+
+ARCV_TARGET_SSE2 void computeWeightedSumsSse2(const float* input, float* sums, std::size_t count, const std::ptrdiff_t* offsets,
+                                              const float* weights, std::size_t weightCount) {
+  std::size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m128 vectors[4] = { _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps() };
+
+    for (std::size_t weightIndex = 0; weightIndex < weightCount; ++weightIndex) {
+      const __m128 weight = _mm_set1_ps(weights[weightIndex]);
+      const float* weightedInput = input + offsets[weightIndex] + i;
+
+      for (uint8_t vecIndex = 0; vecIndex < 4; ++vecIndex)
+        vectors[vecIndex] = _mm_add_ps(vectors[vecIndex], _mm_mul_ps(weight, _mm_loadu_ps(weightedInput + vecIndex * 4)));
+    }
+
+    for (uint8_t vecIndex = 0; vecIndex < 4; ++vecIndex)
+      _mm_storeu_ps(sums + i + vecIndex * 4, vectors[vecIndex]);
+  }
+
+  computeWeightedSumsReference(input + i, sums + i, count - i, offsets, weights, weightCount);
+}
+
+// SSE2 has no 32-bit multiplication, fixed point sums keep the reference loop
+template <typename TI>
+void computeWeightedSumsSse2(const TI* input, int32_t* sums, std::size_t count, const std::ptrdiff_t* offsets,
+                             const int32_t* weights, std::size_t weightCount) {
+  computeWeightedSumsReference(input, sums, count, offsets, weights, weightCount);
+}
+
+// Products by the twiddle add the values multiplied by its real part to the swapped values multiplied by its imaginary
+//  part, negated in the lanes of real parts
+ARCV_TARGET_SSE2 void computeFftStageSse2(float* data, std::size_t sequenceSize, std::size_t rowStride, std::size_t batchSize,
+                                          std::size_t halfLength, const float* twiddles) {
+  forEachButterflyRows(data, sequenceSize, rowStride, halfLength, twiddles,
+                       [batchSize] (float* evenValues, float* oddValues, float twiddleReal, float twiddleImag) ARCV_TARGET_SSE2 {
+    const __m128 realFactors = _mm_set1_ps(twiddleReal);
+    const __m128 imagFactors = _mm_setr_ps(-twiddleImag, twiddleImag, -twiddleImag, twiddleImag);
+    const auto computeProducts = [&realFactors, &imagFactors] (__m128 odd) ARCV_TARGET_SSE2 {
+      return _mm_add_ps(_mm_mul_ps(odd, realFactors), _mm_mul_ps(_mm_shuffle_ps(odd, odd, _MM_SHUFFLE(2, 3, 0, 1)), imagFactors));
+    };
+
+    std::size_t i = 0;
+    for (; i + 2 <= batchSize; i += 2) {
+      const __m128 products = computeProducts(_mm_loadu_ps(oddValues + 2 * i));
+      const __m128 even = _mm_loadu_ps(evenValues + 2 * i);
+
+      _mm_storeu_ps(oddValues + 2 * i, _mm_sub_ps(even, products));
+      _mm_storeu_ps(evenValues + 2 * i, _mm_add_ps(even, products));
+    }
+
+    // A remaining value is loaded & stored alone in the lower half of vectors
+    if (i < batchSize) {
+      const __m128 products = computeProducts(_mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(oddValues + 2 * i))));
+      const __m128 even = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(evenValues + 2 * i)));
+
+      _mm_store_sd(reinterpret_cast<double*>(oddValues + 2 * i), _mm_castps_pd(_mm_sub_ps(even, products)));
+      _mm_store_sd(reinterpret_cast<double*>(evenValues + 2 * i), _mm_castps_pd(_mm_add_ps(even, products)));
+    }
+  });
+}
+
+ARCV_TARGET_SSE2 void computeRecursiveFilterRowSse2(const float* inputs, const float* const* previousRows, float* results,
+                                                    std::size_t count, const float* coefficients) {
+  const __m128 inputFactors = _mm_set1_ps(coefficients[0]);
+  const __m128 firstFactors = _mm_set1_ps(coefficients[1]);
+  const __m128 secondFactors = _mm_set1_ps(coefficients[2]);
+  const __m128 thirdFactors = _mm_set1_ps(coefficients[3]);
+
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128 values = _mm_mul_ps(_mm_loadu_ps(inputs + i), inputFactors);
+    values = _mm_add_ps(values, _mm_mul_ps(_mm_loadu_ps(previousRows[0] + i), firstFactors));
+    values = _mm_add_ps(values, _mm_mul_ps(_mm_loadu_ps(previousRows[1] + i), secondFactors));
+    values = _mm_add_ps(values, _mm_mul_ps(_mm_loadu_ps(previousRows[2] + i), thirdFactors));
+
+    _mm_storeu_ps(results + i, values);
+  }
+
+  for (; i < count; ++i) {
+    float value = inputs[i] * coefficients[0];
+    value += previousRows[0][i] * coefficients[1];
+    value += previousRows[1][i] * coefficients[2];
+    value += previousRows[2][i] * coefficients[3];
+
+    results[i] = value;
+  }
+}
+
+// Vectors going through the median networks, along with their element type's minimum & maximum; they give as well the
+//  rows' extrema of morphological filters
+template <typename T> struct MedianVectorSse2;
+
+template <>
+struct MedianVectorSse2<uint8_t> {
+  static constexpr std::size_t LaneCount = 16;
+
+  ARCV_TARGET_SSE2 static __m128i load(const uint8_t* values) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(values)); }
+  ARCV_TARGET_SSE2 static void store(__m128i vector, uint8_t* values) { _mm_storeu_si128(reinterpret_cast<__m128i*>(values), vector); }
+  ARCV_TARGET_SSE2 static __m128i computeMin(__m128i lhs, __m128i rhs) { return _mm_min_epu8(lhs, rhs); }
+  ARCV_TARGET_SSE2 static __m128i computeMax(__m128i lhs, __m128i rhs) { return _mm_max_epu8(lhs, rhs); }
+};
+
+template <>
+struct MedianVectorSse2<int16_t> {
+  static constexpr std::size_t LaneCount = 8;
+
+  ARCV_TARGET_SSE2 static __m128i load(const int16_t* values) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(values)); }
+  ARCV_TARGET_SSE2 static void store(__m128i vector, int16_t* values) { _mm_storeu_si128(reinterpret_cast<__m128i*>(values), vector); }
+  ARCV_TARGET_SSE2 static __m128i computeMin(__m128i lhs, __m128i rhs) { return _mm_min_epi16(lhs, rhs); }
+  ARCV_TARGET_SSE2 static __m128i computeMax(__m128i lhs, __m128i rhs) { return _mm_max_epi16(lhs, rhs); }
+};
+
+template <>
+struct MedianVectorSse2<float> {
+  static constexpr std::size_t LaneCount = 4;
+
+  ARCV_TARGET_SSE2 static __m128 load(const float* values) { return _mm_loadu_ps(values); }
+  ARCV_TARGET_SSE2 static void store(__m128 vector, float* values) { _mm_storeu_ps(values, vector); }
+  ARCV_TARGET_SSE2 static __m128 computeMin(__m128 lhs, __m128 rhs) { return _mm_min_ps(lhs, rhs); }
+  ARCV_TARGET_SSE2 static __m128 computeMax(__m128 lhs, __m128 rhs) { return _mm_max_ps(lhs, rhs); }
+};
+
+// The last medians are given by a vector overlapping the previous one, some of them being computed twice
+template <typename T>
+ARCV_TARGET_SSE2 void computeMediansSse2(const T* const* inputs, T* medians, std::size_t count, std::size_t inputCount) {
+  using Vector = MedianVectorSse2<T>;
+
+  if (count < Vector::LaneCount)
+    return computeMediansReference(inputs, medians, count, inputCount);
+
+  const MedianNetwork network = getMedianNetwork(inputCount);
+  decltype(Vector::load(medians)) values[25];
+
+  const auto computeVectorMedians = [&] (std::size_t i) ARCV_TARGET_SSE2 {
+    for (std::size_t inputIndex = 0; inputIndex < inputCount; ++inputIndex)
+      values[inputIndex] = Vector::load(inputs[inputIndex] + i);
+
+    for (std::size_t pairIndex = 0; pairIndex < network.pairCount; ++pairIndex) {
+      const auto low = values[network.pairs[pairIndex][0]];
+      const auto high = values[network.pairs[pairIndex][1]];
+
+      values[network.pairs[pairIndex][0]] = Vector::computeMin(low, high);
+      values[network.pairs[pairIndex][1]] = Vector::computeMax(low, high);
+    }
+
+    Vector::store(values[inputCount / 2], medians + i);
+  };
+
+  for (std::size_t i = 0; i + Vector::LaneCount <= count; i += Vector::LaneCount)
+    computeVectorMedians(i);
+
+  if (count % Vector::LaneCount != 0)
+    computeVectorMedians(count - Vector::LaneCount);
+}
+
+template <bool IsMaximum, typename T>
+ARCV_TARGET_SSE2 void computeExtremaSse2(const T* lhs, const T* rhs, T* res, std::size_t count) {
+  using Vector = MedianVectorSse2<T>;
+
+  std::size_t i = 0;
+
+  for (; i + Vector::LaneCount <= count; i += Vector::LaneCount) {
+    const auto lhsVector = Vector::load(lhs + i);
+    const auto rhsVector = Vector::load(rhs + i);
+
+    Vector::store(IsMaximum ? Vector::computeMax(lhsVector, rhsVector) : Vector::computeMin(lhsVector, rhsVector), res + i);
+  }
+
+  computeExtremaReference<IsMaximum>(lhs + i, rhs + i, res + i, count - i);
+}
+
+///////////
+// AVX2 //
+/////////
+
+// Eight pixels fill exactly ChannelCount registers, lane i of the r-th one always holding channel (8r + i) % ChannelCount
+template <uint8_t ChannelCount>
+ARCV_TARGET_AVX2 void accumulateStatisticsAvx2(const float* pixels, std::size_t pixelCount, const double* shifts,
+                                               float* mins, float* maxs, double* sums, double* squaredSums) {
+  __m256 minVecs[ChannelCount], maxVecs[ChannelCount];
+  __m256d shiftVecs[ChannelCount][2], sumVecs[ChannelCount][2], squaredSumVecs[ChannelCount][2];
+
+  for (uint8_t regIndex = 0; regIndex < ChannelCount; ++regIndex) {
+    double laneShifts[8];
+    for (uint8_t laneIndex = 0; laneIndex < 8; ++laneIndex)
+      laneShifts[laneIndex] = shifts[(regIndex * 8 + laneIndex) % ChannelCount];
+
+    minVecs[regIndex] = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+    maxVecs[regIndex] = _mm256_set1_ps(-std::numeric_limits<float>::infinity());
+
+    for (uint8_t halfIndex = 0; halfIndex < 2; ++halfIndex) {
+      shiftVecs[regIndex][halfIndex] = _mm256_loadu_pd(laneShifts + halfIndex * 4);
+      sumVecs[regIndex][halfIndex] = _mm256_setzero_pd();
+      squaredSumVecs[regIndex][halfIndex] = _mm256_setzero_pd();
+    }
+  }
+
+  std::size_t pixelIndex = 0;
+  for (; pixelIndex + 8 <= pixelCount; pixelIndex += 8) {
+    for (uint8_t regIndex = 0; regIndex < ChannelCount; ++regIndex) {
+      const __m256 values = _mm256_loadu_ps(pixels + pixelIndex * ChannelCount + regIndex * 8);
+      minVecs[regIndex] = _mm256_min_ps(minVecs[regIndex], values);
+      maxVecs[regIndex] = _mm256_max_ps(maxVecs[regIndex], values);
+
+      // Sums are kept in double precision, floats not being precise enough for a whole image
+      const __m256d halves[2] = { _mm256_cvtps_pd(_mm256_castps256_ps128(values)), _mm256_cvtps_pd(_mm256_extractf128_ps(values, 1)) };
+
+      for (uint8_t halfIndex = 0; halfIndex < 2; ++halfIndex) {
+        const __m256d shiftedValues = _mm256_sub_pd(halves[halfIndex], shiftVecs[regIndex][halfIndex]);
+        sumVecs[regIndex][halfIndex] = _mm256_add_pd(sumVecs[regIndex][halfIndex], shiftedValues);
+        squaredSumVecs[regIndex][halfIndex] = _mm256_add_pd(squaredSumVecs[regIndex][halfIndex],
+                                                            _mm256_mul_pd(shiftedValues, shiftedValues));
+      }
+    }
+  }
+
+  // Folding every lane into its channel
+  for (uint8_t regIndex = 0; regIndex < ChannelCount; ++regIndex) {
+    float laneMins[8], laneMaxs[8];
+    double laneSums[8], laneSquaredSums[8];
+
+    _mm256_storeu_ps(laneMins, minVecs[regIndex]);
+    _mm256_storeu_ps(laneMaxs, maxVecs[regIndex]);
+    for (uint8_t halfIndex = 0; halfIndex < 2; ++halfIndex) {
+      _mm256_storeu_pd(laneSums + halfIndex * 4, sumVecs[regIndex][halfIndex]);
+      _mm256_storeu_pd(laneSquaredSums + halfIndex * 4, squaredSumVecs[regIndex][halfIndex]);
+    }
+
+    for (uint8_t laneIndex = 0; laneIndex < 8; ++laneIndex) {
+      const uint8_t chan = (regIndex * 8 + laneIndex) % ChannelCount;
+
+      mins[chan] = std::min(mins[chan], laneMins[laneIndex]);
+      maxs[chan] = std::max(maxs[chan], laneMaxs[laneIndex]);
+      sums[chan] += laneSums[laneIndex];
+      squaredSums[chan] += laneSquaredSums[laneIndex];
+    }
+  }
+
+  accumulateStatisticsReference(pixels + pixelIndex * ChannelCount, pixelCount - pixelIndex, ChannelCount, shifts,
+                                mins, maxs, sums, squaredSums);
+}
+
+ARCV_TARGET_AVX2 inline __m256 computeVector(__m256 lhs, __m256 rhs, OperationTag<ARCV_ELEMENTWISE_ADD>) { return _mm256_add_ps(lhs, rhs); }
+ARCV_TARGET_AVX2 inline __m256 computeVector(__m256 lhs, __m256 rhs, OperationTag<ARCV_ELEMENTWISE_SUB>) { return _mm256_sub_ps(lhs, rhs); }
+ARCV_TARGET_AVX2 inline __m256 computeVector(__m256 lhs, __m256 rhs, OperationTag<ARCV_ELEMENTWISE_MUL>) { return _mm256_mul_ps(lhs, rhs); }
+ARCV_TARGET_AVX2 inline __m256 computeVector(__m256 lhs, __m256 rhs, OperationTag<ARCV_ELEMENTWISE_DIV>) { return _mm256_div_ps(lhs, rhs); }
+
+// Unpacking & packing both work within 128-bit lanes, elements thus coming back to their original place
+ARCV_TARGET_AVX2 inline void widenBytes(__m256i bytes, __m256 (&floats)[4]) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i lowWords = _mm256_unpacklo_epi8(bytes, zero);
+  const __m256i highWords = _mm256_unpackhi_epi8(bytes, zero);
+
+  floats[0] = _mm256_cvtepi32_ps(_mm256_unpacklo_epi16(lowWords, zero));
+  floats[1] = _mm256_cvtepi32_ps(_mm256_unpackhi_epi16(lowWords, zero));
+  floats[2] = _mm256_cvtepi32_ps(_mm256_unpacklo_epi16(highWords, zero));
+  floats[3] = _mm256_cvtepi32_ps(_mm256_unpackhi_epi16(highWords, zero));
+}
+
+ARCV_TARGET_AVX2 inline __m256i narrowFloats(const __m256 (&floats)[4]) {
+  const __m256 zero = _mm256_setzero_ps();
+  const __m256 maxVal = _mm256_set1_ps(255.f);
+  __m256i ints[4];
+
+  for (uint8_t i = 0; i < 4; ++i)
+    ints[i] = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(floats[i], zero), maxVal));
+
+  return _mm256_packus_epi16(_mm256_packs_epi32(ints[0], ints[1]), _mm256_packs_epi32(ints[2], ints[3]));
+}
+
+ARCV_TARGET_AVX2 inline __m256i computeBytes(__m256i lhs, __m256i rhs, OperationTag<ARCV_ELEMENTWISE_ADD>) { return _mm256_adds_epu8(lhs, rhs); }
+ARCV_TARGET_AVX2 inline __m256i computeBytes(__m256i lhs, __m256i rhs, OperationTag<ARCV_ELEMENTWISE_SUB>) { return _mm256_subs_epu8(lhs, rhs); }
+
+template <ElementwiseOperation Op>
+ARCV_TARGET_AVX2 inline __m256i computeBytes(__m256i lhs, __m256i rhs, OperationTag<Op> tag) {
+  __m256 lhsFloats[4], rhsFloats[4];
+  widenBytes(lhs, lhsFloats);
+  widenBytes(rhs, rhsFloats);
+
+  for (uint8_t i = 0; i < 4; ++i)
+    lhsFloats[i] = computeVector(lhsFloats[i], rhsFloats[i], tag);
+
+  return narrowFloats(lhsFloats);
+}
+
+template <ElementwiseOperation Op>
+ARCV_TARGET_AVX2 void applyAvx2(float* lhs, const float* rhs, std::size_t count) {
+  std::size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+    _mm256_storeu_ps(lhs + i, computeVector(_mm256_loadu_ps(lhs + i), _mm256_loadu_ps(rhs + i), OperationTag<Op>()));
+
+  applyElementwiseReference<Op>(lhs + i, rhs + i, count - i);
+}
+
+template <ElementwiseOperation Op>
+ARCV_TARGET_AVX2 void applyAvx2(float* lhs, float val, std::size_t count) {
+  const __m256 rhs = _mm256_set1_ps(val);
+
+  std::size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+    _mm256_storeu_ps(lhs + i, computeVector(_mm256_loadu_ps(lhs + i), rhs, OperationTag<Op>()));
+
+  applyElementwiseReference<Op>(lhs + i, val, count - i);
+}
+
+template <ElementwiseOperation Op>
+ARCV_TARGET_AVX2 void applyAvx2(uint8_t* lhs, const uint8_t* rhs, std::size_t count) {
+  std::size_t i = 0;
+  for (; i + 32 <= count; i += 32) {
+    const __m256i lhsBytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i));
+    const __m256i rhsBytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lhs + i), computeBytes(lhsBytes, rhsBytes, OperationTag<Op>()));
+  }
+
+  applyElementwiseReference<Op>(lhs + i, rhs + i, count - i);
+}
+
+template <ElementwiseOperation Op>
+ARCV_TARGET_AVX2 void applyAvx2(uint8_t* lhs, float val, std::size_t count) {
+  const __m256 rhs = _mm256_set1_ps(val);
+
+  std::size_t i = 0;
+  for (; i + 32 <= count; i += 32) {
+    __m256 floats[4];
+    widenBytes(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i)), floats);
+
+    for (uint8_t floatIndex = 0; floatIndex < 4; ++floatIndex)
+      floats[floatIndex] = computeVector(floats[floatIndex], rhs, OperationTag<Op>());
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lhs + i), narrowFloats(floats));
+  }
+
+  applyElementwiseReference<Op>(lhs + i, val, count - i);
+}
+
+// Widening with cvtepu8/cvtepi16 keeps elements in order, unlike unpacking
+ARCV_TARGET_AVX2 inline void loadFloats(const uint8_t* input, __m256 (&floats)[4]) {
+  for (uint8_t i = 0; i < 4; ++i)
+    floats[i] = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(input + i * 8))));
+}
+
+ARCV_TARGET_AVX2 inline void loadFloats(const int16_t* input, __m256 (&floats)[4]) {
+  for (uint8_t i = 0; i < 4; ++i)
+    floats[i] = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i * 8))));
+}
+
+ARCV_TARGET_AVX2 inline void loadFloats(const float* input, __m256 (&floats)[4]) {
+  for (uint8_t i = 0; i < 4; ++i)
+    floats[i] = _mm256_loadu_ps(input + i * 8);
+}
+
+// Packing interleaves 128-bit lanes, which have to be put back in order afterwards
+ARCV_TARGET_AVX2 inline void storeFloats(const __m256 (&floats)[4], uint8_t* output) {
+  const __m256i bytes = _mm256_permutevar8x32_epi32(narrowFloats(floats), _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), bytes);
+}
+
+ARCV_TARGET_AVX2 inline void storeFloats(const __m256 (&floats)[4], int16_t* output) {
+  const __m256 minVal = _mm256_set1_ps(-32768.f);
+  const __m256 maxVal = _mm256_set1_ps(32767.f);
+  __m256i ints[4];
+
+  for (uint8_t i = 0; i < 4; ++i)
+    ints[i] = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(floats[i], minVal), maxVal));
+
+  for (uint8_t i = 0; i < 2; ++i) {
+    const __m256i words = _mm256_permute4x64_epi64(_mm256_packs_epi32(ints[i * 2], ints[i * 2 + 1]), _MM_SHUFFLE(3, 1, 2, 0));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i * 16), words);
+  }
+}
+
+ARCV_TARGET_AVX2 inline void storeFloats(const __m256 (&floats)[4], float* output) {
+  for (uint8_t i = 0; i < 4; ++i)
+    _mm256_storeu_ps(output + i * 8, floats[i]);
+}
+
+template <typename TI, typename TO>
+ARCV_TARGET_AVX2 void convertAvx2(const TI* input, TO* output, std::size_t count, float scale, float offset) {
+  const __m256 scaleVec = _mm256_set1_ps(scale);
+  const __m256 offsetVec = _mm256_set1_ps(offset);
+
+  std::size_t i = 0;
+  for (; i + 32 <= count; i += 32) {
+    __m256 floats[4];
+    loadFloats(input + i, floats);
+
+    for (uint8_t floatIndex = 0; floatIndex < 4; ++floatIndex)
+      floats[floatIndex] = _mm256_add_ps(_mm256_mul_ps(floats[floatIndex], scaleVec), offsetVec);
+
+    storeFloats(floats, output + i);
+  }
+
+  convertReference(input + i, output + i, count - i, scale, offset);
+}
+
+// Four vectors of sums stay in registers while going through all the weights, hiding the additions' latency
+template <typename TI, typename TA>
+ARCV_TARGET_AVX2 void computeWeightedSumsAvx2(const TI* input, TA* sums, std::size_t count, const std::ptrdiff_t* offsets,
+                                              const TA* weights, std::size_t weightCount) {
+  using Vector = typename SumVector<TA, ARCV_SIMD_AVX2>::Type;
+
+  Vector zero;
+  broadcastVector(TA(0), zero);
+
+  std::size_t i = 0;
+  for (; i + 32 <= count; i += 32) {
+    Vector vectors[4] = { zero, zero, zero, zero };
+
+    for (std::size_t weightIndex = 0; weightIndex < weightCount; ++weightIndex) {
+      Vector weight;
+      broadcastVector(weights[weightIndex], weight);
+      const TI* weightedInput = input + offsets[weightIndex] + i;
+
+      for (uint8_t vecIndex = 0; vecIndex < 4; ++vecIndex) {
+        Vector values;
+        loadVector(weightedInput + vecIndex * 8, values);
+        vectors[vecIndex] = multiplyAdd(vectors[vecIndex], weight, values);
+      }
+    }
+
+    for (uint8_t vecIndex = 0; vecIndex < 4; ++vecIndex)
+      storeVector(vectors[vecIndex], sums + i + vecIndex * 8);
+  }
+
+  computeWeightedSumsReference(input + i, sums + i, count - i, offsets, weights, weightCount);
+}
+
+ARCV_TARGET_AVX2 void computeFftStageAvx2(float* data, std::size_t sequenceSize, std::size_t rowStride, std::size_t batchSize,
+                                          std::size_t halfLength, const float* twiddles) {
+  forEachButterflyRows(data, sequenceSize, rowStride, halfLength, twiddles,
+                       [batchSize] (float* evenValues, float* oddValues, float twiddleReal, float twiddleImag) ARCV_TARGET_AVX2 {
+    const __m256 realFactors = _mm256_set1_ps(twiddleReal);
+    const __m256 imagFactors = _mm256_setr_ps(-twiddleImag, twiddleImag, -twiddleImag, twiddleImag,
+                                              -twiddleImag, twiddleImag, -twiddleImag, twiddleImag);
+    const auto computeProducts = [&realFactors, &imagFactors] (__m256 odd) ARCV_TARGET_AVX2 {
+      return _mm256_add_ps(_mm256_mul_ps(odd, realFactors), _mm256_mul_ps(_mm256_permute_ps(odd, 0xB1), imagFactors));
+    };
+
+    std::size_t i = 0;
+    for (; i + 4 <= batchSize; i += 4) {
+      const __m256 products = computeProducts(_mm256_loadu_ps(oddValues + 2 * i));
+      const __m256 even = _mm256_loadu_ps(evenValues + 2 * i);
+
+      _mm256_storeu_ps(oddValues + 2 * i, _mm256_sub_ps(even, products));
+      _mm256_storeu_ps(evenValues + 2 * i, _mm256_add_ps(even, products));
+    }
+
+    // Remaining values are loaded & stored one by one, masked accesses defeating the forwarding of stores to next stages'
+    //  loads; upper lanes are computed on zeros & discarded
+    for (; i < batchSize; ++i) {
+      const __m256 odd = _mm256_zextps128_ps256(_mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(oddValues + 2 * i))));
+      const __m256 even = _mm256_zextps128_ps256(_mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(evenValues + 2 * i))));
+      const __m256 products = computeProducts(odd);
+
+      _mm_store_sd(reinterpret_cast<double*>(oddValues + 2 * i), _mm_castps_pd(_mm256_castps256_ps128(_mm256_sub_ps(even, products))));
+      _mm_store_sd(reinterpret_cast<double*>(evenValues + 2 * i), _mm_castps_pd(_mm256_castps256_ps128(_mm256_add_ps(even, products))));
+    }
+  });
+}
+
+ARCV_TARGET_AVX2 void computeRecursiveFilterRowAvx2(const float* inputs, const float* const* previousRows, float* results,
+                                                    std::size_t count, const float* coefficients) {
+  const __m256 inputFactors = _mm256_set1_ps(coefficients[0]);
+  const __m256 firstFactors = _mm256_set1_ps(coefficients[1]);
+  const __m256 secondFactors = _mm256_set1_ps(coefficients[2]);
+  const __m256 thirdFactors = _mm256_set1_ps(coefficients[3]);
+
+  std::size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256 values = _mm256_mul_ps(_mm256_loadu_ps(inputs + i), inputFactors);
+    values = _mm256_add_ps(values, _mm256_mul_ps(_mm256_loadu_ps(previousRows[0] + i), firstFactors));
+    values = _mm256_add_ps(values, _mm256_mul_ps(_mm256_loadu_ps(previousRows[1] + i), secondFactors));
+    values = _mm256_add_ps(values, _mm256_mul_ps(_mm256_loadu_ps(previousRows[2] + i), thirdFactors));
+
+    _mm256_storeu_ps(results + i, values);
+  }
+
+  for (; i < count; ++i) {
+    float value = inputs[i] * coefficients[0];
+    value += previousRows[0][i] * coefficients[1];
+    value += previousRows[1][i] * coefficients[2];
+    value += previousRows[2][i] * coefficients[3];
+
+    results[i] = value;
+  }
+}
+
+template <typename T> struct MedianVectorAvx2;
+
+template <>
+struct MedianVectorAvx2<uint8_t> {
+  static constexpr std::size_t LaneCount = 32;
+
+  ARCV_TARGET_AVX2 static __m256i load(const uint8_t* values) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values)); }
+  ARCV_TARGET_AVX2 static void store(__m256i vector, uint8_t* values) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(values), vector); }
+  ARCV_TARGET_AVX2 static __m256i computeMin(__m256i lhs, __m256i rhs) { return _mm256_min_epu8(lhs, rhs); }
+  ARCV_TARGET_AVX2 static __m256i computeMax(__m256i lhs, __m256i rhs) { return _mm256_max_epu8(lhs, rhs); }
+};
+
+template <>
+struct MedianVectorAvx2<int16_t> {
+  static constexpr std::size_t LaneCount = 16;
+
+  ARCV_TARGET_AVX2 static __m256i load(const int16_t* values) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values)); }
+  ARCV_TARGET_AVX2 static void store(__m256i vector, int16_t* values) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(values), vector); }
+  ARCV_TARGET_AVX2 static __m256i computeMin(__m256i lhs, __m256i rhs) { return _mm256_min_epi16(lhs, rhs); }
+  ARCV_TARGET_AVX2 static __m256i computeMax(__m256i lhs, __m256i rhs) { return _mm256_max_epi16(lhs, rhs); }
+};
+
+template <>
+struct MedianVectorAvx2<float> {
+  static constexpr std::size_t LaneCount = 8;
+
+  ARCV_TARGET_AVX2 static __m256 load(const float* values) { return _mm256_loadu_ps(values); }
+  ARCV_TARGET_AVX2 static void store(__m256 vector, float* values) { _mm256_storeu_ps(values, vector); }
+  ARCV_TARGET_AVX2 static __m256 computeMin(__m256 lhs, __m256 rhs) { return _mm256_min_ps(lhs, rhs); }
+  ARCV_TARGET_AVX2 static __m256 computeMax(__m256 lhs, __m256 rhs) { return _mm256_max_ps(lhs, rhs); }
+};
+
+template <typename T>
+ARCV_TARGET_AVX2 void computeMediansAvx2(const T* const* inputs, T* medians, std::size_t count, std::size_t inputCount) {
+  using Vector = MedianVectorAvx2<T>;
+
+  if (count < Vector::LaneCount)
+    return computeMediansReference(inputs, medians, count, inputCount);
+
+  const MedianNetwork network = getMedianNetwork(inputCount);
+  decltype(Vector::load(medians)) values[25];
+
+  const auto computeVectorMedians = [&] (std::size_t i) ARCV_TARGET_AVX2 {
+    for (std::size_t inputIndex = 0; inputIndex < inputCount; ++inputIndex)
+      values[inputIndex] = Vector::load(inputs[inputIndex] + i);
+
+    for (std::size_t pairIndex = 0; pairIndex < network.pairCount; ++pairIndex) {
+      const auto low = values[network.pairs[pairIndex][0]];
+      const auto high = values[network.pairs[pairIndex][1]];
+
+      values[network.pairs[pairIndex][0]] = Vector::computeMin(low, high);
+      values[network.pairs[pairIndex][1]] = Vector::computeMax(low, high);
+    }
+
+    Vector::store(values[inputCount / 2], medians + i);
+  };
+
+  for (std::size_t i = 0; i + Vector::LaneCount <= count; i += Vector::LaneCount)
+    computeVectorMedians(i);
+
+  if (count % Vector::LaneCount != 0)
+    computeVectorMedians(count - Vector::LaneCount);
+}
+
+template <bool IsMaximum, typename T>
+ARCV_TARGET_AVX2 void computeExtremaAvx2(const T* lhs, const T* rhs, T* res, std::size_t count) {
+  using Vector = MedianVectorAvx2<T>;
+
+  std::size_t i = 0;
+
+  for (; i + Vector::LaneCount <= count; i += Vector::LaneCount) {
+    const auto lhsVector = Vector::load(lhs + i);
+    const auto rhsVector = Vector::load(rhs + i);
+
+    Vector::store(IsMaximum ? Vector::computeMax(lhsVector, rhsVector) : Vector::computeMin(lhsVector, rhsVector), res + i);
+  }
+
+  computeExtremaReference<IsMaximum>(lhs + i, rhs + i, res + i, count - i);
+}
+
+// Byte shuffle masks for ChannelCount 16-byte vectors of interleaved pixels: planeMasks[chan][vec] gathers, from the
+//  vec-th vector of pixels, the bytes going into the plane of channel chan; pixelMasks[vec][chan] does the reverse
+//  from a plane's vector; bytes coming from another vector are zeroed (0x80), so that the shuffles can be ORed together
+template <typename T, uint8_t ChannelCount>
+struct InterleavingMasks {
+  InterleavingMasks() {
+    for (uint8_t vecIndex = 0; vecIndex < ChannelCount; ++vecIndex) {
+      for (uint8_t chan = 0; chan < ChannelCount; ++chan) {
+        for (uint8_t byteIndex = 0; byteIndex < 16; ++byteIndex) {
+          const std::size_t planeByteIndex = ((byteIndex / sizeof(T)) * ChannelCount + chan) * sizeof(T) + byteIndex % sizeof(T);
+          planeMasks[chan][vecIndex][byteIndex] = (planeByteIndex / 16 == vecIndex ? planeByteIndex % 16 : 0x80);
+
+          const std::size_t pixelEltIndex = (vecIndex * 16 + byteIndex) / sizeof(T);
+          pixelMasks[vecIndex][chan][byteIndex] = (pixelEltIndex % ChannelCount == chan
+                                                   ? (pixelEltIndex / ChannelCount) * sizeof(T) + byteIndex % sizeof(T)
+                                                   : 0x80);
+        }
+      }
+    }
+  }
+
+  alignas(16) uint8_t planeMasks[ChannelCount][ChannelCount][16];
+  alignas(16) uint8_t pixelMasks[ChannelCount][ChannelCount][16];
+};
+
+// Byte shuffles only exist within 128-bit lanes, which interleaved pixels would otherwise cross; 16-byte vectors are kept
+template <typename T, uint8_t ChannelCount>
+ARCV_TARGET_AVX2 void deinterleaveAvx2(const T* pixels, std::size_t pixelCount, T* const* planes) {
+  static const InterleavingMasks<T, ChannelCount> masks;
+  constexpr std::size_t VecPixelCount = 16 / sizeof(T);
+
+  std::size_t pixelIndex = 0;
+  for (; pixelIndex + VecPixelCount <= pixelCount; pixelIndex += VecPixelCount) {
+    __m128i pixelVecs[ChannelCount];
+    for (uint8_t vecIndex = 0; vecIndex < ChannelCount; ++vecIndex)
+      pixelVecs[vecIndex] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + pixelIndex * ChannelCount) + vecIndex);
+
+    for (uint8_t chan = 0; chan < ChannelCount; ++chan) {
+      __m128i planeVec = _mm_setzero_si128();
+
+      for (uint8_t vecIndex = 0; vecIndex < ChannelCount; ++vecIndex) {
+        const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i*>(masks.planeMasks[chan][vecIndex]));
+        planeVec = _mm_or_si128(planeVec, _mm_shuffle_epi8(pixelVecs[vecIndex], mask));
+      }
+
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(planes[chan] + pixelIndex), planeVec);
+    }
+  }
+
+  T* remainingPlanes[ChannelCount];
+  for (uint8_t chan = 0; chan < ChannelCount; ++chan)
+    remainingPlanes[chan] = planes[chan] + pixelIndex;
+
+  deinterleaveReference(pixels + pixelIndex * ChannelCount, pixelCount - pixelIndex, ChannelCount, remainingPlanes);
+}
+
+template <typename T, uint8_t ChannelCount>
+ARCV_TARGET_AVX2 void interleaveAvx2(const T* const* planes, std::size_t pixelCount, T* pixels) {
+  static const InterleavingMasks<T, ChannelCount> masks;
+  constexpr std::size_t VecPixelCount = 16 / sizeof(T);
+
+  std::size_t pixelIndex = 0;
+  for (; pixelIndex + VecPixelCount <= pixelCount; pixelIndex += VecPixelCount) {
+    __m128i planeVecs[ChannelCount];
+    for (uint8_t chan = 0; chan < ChannelCount; ++chan)
+      planeVecs[chan] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes[chan] + pixelIndex));
+
+    for (uint8_t vecIndex = 0; vecIndex < ChannelCount; ++vecIndex) {
+      __m128i pixelVec = _mm_setzero_si128();
+
+      for (uint8_t chan = 0; chan < ChannelCount; ++chan) {
+        const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i*>(masks.pixelMasks[vecIndex][chan]));
+        pixelVec = _mm_or_si128(pixelVec, _mm_shuffle_epi8(planeVecs[chan], mask));
+      }
+
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + pixelIndex * ChannelCount) + vecIndex, pixelVec);
+    }
+  }
+
+  const T* remainingPlanes[ChannelCount];
+  for (uint8_t chan = 0; chan < ChannelCount; ++chan)
+    remainingPlanes[chan] = planes[chan] + pixelIndex;
+
+  interleaveReference(remainingPlanes, pixelCount - pixelIndex, ChannelCount, pixels + pixelIndex * ChannelCount);
+}
+
+/////////////
+// AVX512 //
+///////////
+
+ARCV_TARGET_AVX512 inline __m512 computeVector(__m512 lhs, __m512 rhs, OperationTag<ARCV_ELEMENTWISE_ADD>) { return _mm512_add_ps(lhs, rhs); }
+ARCV_TARGET_AVX512 inline __m512 computeVector(__m512 lhs, __m512 rhs, OperationTag<ARCV_ELEMENTWISE_SUB>) { return _mm512_sub_ps(lhs, rhs); }
+ARCV_TARGET_AVX512 inline __m512 computeVector(__m512 lhs, __m512 rhs, OperationTag<ARCV_ELEMENTWISE_MUL>) { return _mm512_mul_ps(lhs, rhs); }
+ARCV_TARGET_AVX512 inline __m512 computeVector(__m512 lhs, __m512 rhs, OperationTag<ARCV_ELEMENTWISE_DIV>) { return _mm512_div_ps(lhs, rhs); }
+
+ARCV_TARGET_AVX512 inline void widenBytes(__m512i bytes, __m512 (&floats)[4]) {
+  const __m512i zero = _mm512_setzero_si512();
+  const __m512i lowWords = _mm512_unpacklo_epi8(bytes, zero);
+  const __m512i highWords = _mm512_unpackhi_epi8(bytes, zero);
+
+  floats[0] = _mm512_maskz_cvtepi32_ps(allLanes, _mm512_unpacklo_epi16(lowWords, zero));
+  floats[1] = _mm512_maskz_cvtepi32_ps(allLanes, _mm512_unpackhi_epi16(lowWords, zero));
+  floats[2] = _mm512_maskz_cvtepi32_ps(allLanes, _mm512_unpacklo_epi16(highWords, zero));
+  floats[3] = _mm512_maskz_cvtepi32_ps(allLanes, _mm512_unpackhi_epi16(highWords, zero));
+}
+
+ARCV_TARGET_AVX512 inline __m512i narrowFloats(const __m512 (&floats)[4]) {
+  const __m512 zero = _mm512_setzero_ps();
+  const __m512 maxVal = _mm512_set1_ps(255.f);
+  __m512i ints[4];
+
+  for (uint8_t i = 0; i < 4; ++i)
+    ints[i] = _mm512_maskz_cvttps_epi32(allLanes, _mm512_maskz_min_ps(allLanes, _mm512_maskz_max_ps(allLanes, floats[i], zero), maxVal));
+
+  return _mm512_packus_epi16(_mm512_packs_epi32(ints[0], ints[1]), _mm512_packs_epi32(ints[2], ints[3]));
+}
+
+ARCV_TARGET_AVX512 inline __m512i computeBytes(__m512i lhs, __m512i rhs, OperationTag<ARCV_ELEMENTWISE_ADD>) { return _mm512_adds_epu8(lhs, rhs); }
+ARCV_TARGET_AVX512 inline __m512i computeBytes(__m512i lhs, __m512i rhs, OperationTag<ARCV_ELEMENTWISE_SUB>) { return _mm512_subs_epu8(lhs, rhs); }
+
+template <ElementwiseOperation Op>
+ARCV_TARGET_AVX512 inline __m512i computeBytes(__m512i lhs, __m512i rhs, OperationTag<Op> tag) {
+  __m512 lhsFloats[4], rhsFloats[4];
+  widenBytes(lhs, lhsFloats);
+  widenBytes(rhs, rhsFloats);
+
+  for (uint8_t i = 0; i < 4; ++i)
+    lhsFloats[i] = computeVector(lhsFloats[i], rhsFloats[i], tag);
+
+  return narrowFloats(lhsFloats);
+}
+
+template <ElementwiseOperation Op>
+ARCV_TARGET_AVX512 void applyAvx512(float* lhs, const float* rhs, std::size_t count) {
+  std::size_t i = 0;
+  for (; i + 16 <= count; i += 16)
+    _mm512_storeu_ps(lhs + i, computeVector(_mm512_loadu_ps(lhs + i), _mm512_loadu_ps(rhs + i), OperationTag<Op>()));
+
+  applyElementwiseReference<Op>(lhs + i, rhs + i, count - i);
+}
+
+template <ElementwiseOperation Op>
+ARCV_TARGET_AVX512 void applyAvx512(float* lhs, float val, std::size_t count) {
+  const __m512 rhs = _mm512_set1_ps(val);
+
+  std::size_t i = 0;
+  for (; i + 16 <= count; i += 16)
+    _mm512_storeu_ps(lhs + i, computeVector(_mm512_loadu_ps(lhs + i), rhs, OperationTag<Op>()));
+
+  applyElementwiseReference<Op>(lhs + i, val, count - i);
+}
+
+template <ElementwiseOperation Op>
+ARCV_TARGET_AVX512 void applyAvx512(uint8_t* lhs, const uint8_t* rhs, std::size_t count) {
+  std::size_t i = 0;
+  for (; i + 64 <= count; i += 64) {
+    const __m512i lhsBytes = _mm512_loadu_si512(lhs + i);
+    const __m512i rhsBytes = _mm512_loadu_si512(rhs + i);
+    _mm512_storeu_si512(lhs + i, computeBytes(lhsBytes, rhsBytes, OperationTag<Op>()));
+  }
+
+  applyElementwiseReference<Op>(lhs + i, rhs + i, count - i);
+}
+
+template <ElementwiseOperation Op>
+ARCV_TARGET_AVX512 void applyAvx512(uint8_t* lhs, float val, std::size_t count) {
+  const __m512 rhs = _mm512_set1_ps(val);
+
+  std::size_t i = 0;
+  for (; i + 64 <= count; i += 64) {
+    __m512 floats[4];
+    widenBytes(_mm512_loadu_si512(lhs + i), floats);
+
+    for (uint8_t floatIndex = 0; floatIndex < 4; ++floatIndex)
+      floats[floatIndex] = computeVector(floats[floatIndex], rhs, OperationTag<Op>());
+
+    _mm512_storeu_si512(lhs + i, narrowFloats(floats));
+  }
+
+  applyElementwiseReference<Op>(lhs + i, val, count - i);
+}
+
+template <typename TI, typename TA>
+ARCV_TARGET_AVX512 void computeWeightedSumsAvx512(const TI* input, TA* sums, std::size_t count, const std::ptrdiff_t* offsets,
+                                                  const TA* weights, std::size_t weightCount) {
+  using Vector = typename SumVector<TA, ARCV_SIMD_AVX512>::Type;
+
+  Vector zero;
+  broadcastVector(TA(0), zero);
+
+  std::size_t i = 0;
+  for (; i + 64 <= count; i += 64) {
+    Vector vectors[4] = { zero, zero, zero, zero };
+
+    for (std::size_t weightIndex = 0; weightIndex < weightCount; ++weightIndex) {
+      Vector weight;
+      broadcastVector(weights[weightIndex], weight);
+      const TI* weightedInput = input + offsets[weightIndex] + i;
+
+      for (uint8_t vecIndex = 0; vecIndex < 4; ++vecIndex) {
+        Vector values;
+        loadVector(weightedInput + vecIndex * 16, values);
+        vectors[vecIndex] = multiplyAdd(vectors[vecIndex], weight, values);
+      }
+    }
+
+    for (uint8_t vecIndex = 0; vecIndex < 4; ++vecIndex)
+      storeVector(vectors[vecIndex], sums + i + vecIndex * 16);
+  }
+
+  // Remaining elements go through the AVX2 kernel, of which most will still fill its registers
+  computeWeightedSumsAvx2(input + i, sums + i, count - i, offsets, weights, weightCount);
+}
+
+// As for weighted sums, operations with an explicit rounding mode keep GCC from contracting them into FMAs
+ARCV_TARGET_AVX512 void computeFftStageAvx512(float* data, std::size_t sequenceSize, std::size_t rowStride, std::size_t batchSize,
+                                              std::size_t halfLength, const float* twiddles) {
+  forEachButterflyRows(data, sequenceSize, rowStride, halfLength, twiddles,
+                       [batchSize] (float* evenValues, float* oddValues, float twiddleReal, float twiddleImag) ARCV_TARGET_AVX512 {
+    const __m512 realFactors = _mm512_set1_ps(twiddleReal);
+    const __m512 imagFactors = _mm512_mask_blend_ps(0xAAAA, _mm512_set1_ps(-twiddleImag), _mm512_set1_ps(twiddleImag));
+    const auto computeProducts = [&realFactors, &imagFactors] (__m512 odd) ARCV_TARGET_AVX512 {
+      const __m512 realProducts = _mm512_maskz_mul_round_ps(allLanes, odd, realFactors, _MM_FROUND_CUR_DIRECTION);
+      const __m512 imagProducts = _mm512_maskz_mul_round_ps(allLanes, _mm512_maskz_permute_ps(allLanes, odd, 0xB1), imagFactors,
+                                                            _MM_FROUND_CUR_DIRECTION);
+      return _mm512_maskz_add_round_ps(allLanes, realProducts, imagProducts, _MM_FROUND_CUR_DIRECTION);
+    };
+
+    std::size_t i = 0;
+    for (; i + 8 <= batchSize; i += 8) {
+      const __m512 products = computeProducts(_mm512_loadu_ps(oddValues + 2 * i));
+      const __m512 even = _mm512_loadu_ps(evenValues + 2 * i);
+
+      _mm512_storeu_ps(oddValues + 2 * i, _mm512_sub_ps(even, products));
+      _mm512_storeu_ps(evenValues + 2 * i, _mm512_add_ps(even, products));
+    }
+
+    // As with AVX2, remaining values are loaded & stored one by one
+    for (; i < batchSize; ++i) {
+      const __m512 odd = _mm512_zextps128_ps512(_mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(oddValues + 2 * i))));
+      const __m512 even = _mm512_zextps128_ps512(_mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(evenValues + 2 * i))));
+      const __m512 products = computeProducts(odd);
+
+      _mm_store_sd(reinterpret_cast<double*>(oddValues + 2 * i), _mm_castps_pd(_mm512_maskz_extractf32x4_ps(0xF, _mm512_sub_ps(even, products), 0)));
+      _mm_store_sd(reinterpret_cast<double*>(evenValues + 2 * i), _mm_castps_pd(_mm512_maskz_extractf32x4_ps(0xF, _mm512_add_ps(even, products), 0)));
+    }
+  });
+}
+
+ARCV_TARGET_AVX512 void computeRecursiveFilterRowAvx512(const float* inputs, const float* const* previousRows, float* results,
+                                                        std::size_t count, const float* coefficients) {
+  const __m512 inputFactors = _mm512_set1_ps(coefficients[0]);
+  const __m512 firstFactors = _mm512_set1_ps(coefficients[1]);
+  const __m512 secondFactors = _mm512_set1_ps(coefficients[2]);
+  const __m512 thirdFactors = _mm512_set1_ps(coefficients[3]);
+
+  // The last values are loaded & stored under a mask, which is only done once per row
+  for (std::size_t i = 0; i < count; i += 16) {
+    const __mmask16 mask = (count - i >= 16 ? allLanes : static_cast<__mmask16>((1u << (count - i)) - 1));
+
+    __m512 values = _mm512_maskz_mul_round_ps(allLanes, _mm512_maskz_loadu_ps(mask, inputs + i), inputFactors, _MM_FROUND_CUR_DIRECTION);
+    values = _mm512_maskz_add_round_ps(allLanes, values,
+                                       _mm512_maskz_mul_round_ps(allLanes, _mm512_maskz_loadu_ps(mask, previousRows[0] + i), firstFactors,
+                                                                 _MM_FROUND_CUR_DIRECTION),
+                                       _MM_FROUND_CUR_DIRECTION);
+    values = _mm512_maskz_add_round_ps(allLanes, values,
+                                       _mm512_maskz_mul_round_ps(allLanes, _mm512_maskz_loadu_ps(mask, previousRows[1] + i), secondFactors,
+                                                                 _MM_FROUND_CUR_DIRECTION),
+                                       _MM_FROUND_CUR_DIRECTION);
+    values = _mm512_maskz_add_round_ps(allLanes, values,
+                                       _mm512_maskz_mul_round_ps(allLanes, _mm512_maskz_loadu_ps(mask, previousRows[2] + i), thirdFactors,
+                                                                 _MM_FROUND_CUR_DIRECTION),
+                                       _MM_FROUND_CUR_DIRECTION);
+
+    _mm512_mask_storeu_ps(results + i, mask, values);
+  }
+}
+
+template <typename T> struct MedianVectorAvx512;
+
+template <>
+struct MedianVectorAvx512<uint8_t> {
+  static constexpr std::size_t LaneCount = 64;
+
+  ARCV_TARGET_AVX512 static __m512i load(const uint8_t* values) { return _mm512_loadu_si512(values); }
+  ARCV_TARGET_AVX512 static void store(__m512i vector, uint8_t* values) { _mm512_storeu_si512(values, vector); }
+  ARCV_TARGET_AVX512 static __m512i computeMin(__m512i lhs, __m512i rhs) { return _mm512_min_epu8(lhs, rhs); }
+  ARCV_TARGET_AVX512 static __m512i computeMax(__m512i lhs, __m512i rhs) { return _mm512_max_epu8(lhs, rhs); }
+};
+
+template <>
+struct MedianVectorAvx512<int16_t> {
+  static constexpr std::size_t LaneCount = 32;
+
+  ARCV_TARGET_AVX512 static __m512i load(const int16_t* values) { return _mm512_loadu_si512(values); }
+  ARCV_TARGET_AVX512 static void store(__m512i vector, int16_t* values) { _mm512_storeu_si512(values, vector); }
+  ARCV_TARGET_AVX512 static __m512i computeMin(__m512i lhs, __m512i rhs) { return _mm512_min_epi16(lhs, rhs); }
+  ARCV_TARGET_AVX512 static __m512i computeMax(__m512i lhs, __m512i rhs) { return _mm512_max_epi16(lhs, rhs); }
+};
+
+template <>
+struct MedianVectorAvx512<float> {
+  static constexpr std::size_t LaneCount = 16;
+
+  ARCV_TARGET_AVX512 static __m512 load(const float* values) { return _mm512_loadu_ps(values); }
+  ARCV_TARGET_AVX512 static void store(__m512 vector, float* values) { _mm512_storeu_ps(values, vector); }
+  ARCV_TARGET_AVX512 static __m512 computeMin(__m512 lhs, __m512 rhs) { return _mm512_maskz_min_ps(allLanes, lhs, rhs); }
+  ARCV_TARGET_AVX512 static __m512 computeMax(__m512 lhs, __m512 rhs) { return _mm512_maskz_max_ps(allLanes, lhs, rhs); }
+};
+
+template <typename T>
+ARCV_TARGET_AVX512 void computeMediansAvx512(const T* const* inputs, T* medians, std::size_t count, std::size_t inputCount) {
+  using Vector = MedianVectorAvx512<T>;
+
+  if (count < Vector::LaneCount)
+    return computeMediansReference(inputs, medians, count, inputCount);
+
+  const MedianNetwork network = getMedianNetwork(inputCount);
+  decltype(Vector::load(medians)) values[25];
+
+  const auto computeVectorMedians = [&] (std::size_t i) ARCV_TARGET_AVX512 {
+    for (std::size_t inputIndex = 0; inputIndex < inputCount; ++inputIndex)
+      values[inputIndex] = Vector::load(inputs[inputIndex] + i);
+
+    for (std::size_t pairIndex = 0; pairIndex < network.pairCount; ++pairIndex) {
+      const auto low = values[network.pairs[pairIndex][0]];
+      const auto high = values[network.pairs[pairIndex][1]];
+
+      values[network.pairs[pairIndex][0]] = Vector::computeMin(low, high);
+      values[network.pairs[pairIndex][1]] = Vector::computeMax(low, high);
+    }
+
+    Vector::store(values[inputCount / 2], medians + i);
+  };
+
+  for (std::size_t i = 0; i + Vector::LaneCount <= count; i += Vector::LaneCount)
+    computeVectorMedians(i);
+
+  if (count % Vector::LaneCount != 0)
+    computeVectorMedians(count - Vector::LaneCount);
+}
+
+template <bool IsMaximum, typename T>
+ARCV_TARGET_AVX512 void computeExtremaAvx512(const T* lhs, const T* rhs, T* res, std::size_t count) {
+  using Vector = MedianVectorAvx512<T>;
+
+  std::size_t i = 0;
+
+  for (; i + Vector::LaneCount <= count; i += Vector::LaneCount) {
+    const auto lhsVector = Vector::load(lhs + i);
+    const auto rhsVector = Vector::load(rhs + i);
+
+    Vector::store(IsMaximum ? Vector::computeMax(lhsVector, rhsVector) : Vector::computeMin(lhsVector, rhsVector), res + i);
+  }
+
+  computeExtremaReference<IsMaximum>(lhs + i, rhs + i, res + i, count - i);
+}
+
+#endif // ARCV_SIMD_X86
+
+// Rhs being either a pointer to the other operand's elements or a scalar
+template <ElementwiseOperation Op, typename T, typename Rhs>
+void dispatchElementwise(T* lhs, Rhs rhs, std::size_t count) {
+  switch (getCurrentInstructionSet()) {
+#ifdef ARCV_SIMD_X86
+    case ARCV_SIMD_AVX512:
+      applyAvx512<Op>(lhs, rhs, count);
+      break;
+
+    case ARCV_SIMD_AVX2:
+      applyAvx2<Op>(lhs, rhs, count);
+      break;
+
+    case ARCV_SIMD_SSE2:
+      applySse2<Op>(lhs, rhs, count);
+      break;
+#endif
+
+    default:
+      applyElementwiseReference<Op>(lhs, rhs, count);
+      break;
+  }
+}
+
+template <typename TI, typename TO>
+void dispatchConversion(const TI* input, TO* output, std::size_t count, float scale, float offset) {
+  switch (getCurrentInstructionSet()) {
+#ifdef ARCV_SIMD_X86
+    // Conversions are bound by memory bandwidth rather than by register width; AVX-512 CPUs run the AVX2 kernel
+    case ARCV_SIMD_AVX512:
+    case ARCV_SIMD_AVX2:
+      convertAvx2(input, output, count, scale, offset);
+      break;
+
+    case ARCV_SIMD_SSE2:
+      convertSse2(input, output, count, scale, offset);
+      break;
+#endif
+
+    default:
+      convertReference(input, output, count, scale, offset);
+      break;
+  }
+}
+
+template <typename T>
+void dispatchDeinterleaving(const T* pixels, std::size_t pixelCount, uint8_t channelCount, T* const* planes) {
+#ifdef ARCV_SIMD_X86
+  // Byte shuffles came after SSE2, CPUs limited to it keep the reference loop
+  if (getCurrentInstructionSet() >= ARCV_SIMD_AVX2) {
+    switch (channelCount) {
+      case 2:
+        return deinterleaveAvx2<T, 2>(pixels, pixelCount, planes);
+
+      case 3:
+        return deinterleaveAvx2<T, 3>(pixels, pixelCount, planes);
+
+      case 4:
+        return deinterleaveAvx2<T, 4>(pixels, pixelCount, planes);
+
+      default:
+        break;
+    }
+  }
+#endif
+
+  deinterleaveReference(pixels, pixelCount, channelCount, planes);
+}
+
+template <typename T>
+void dispatchInterleaving(const T* const* planes, std::size_t pixelCount, uint8_t channelCount, T* pixels) {
+#ifdef ARCV_SIMD_X86
+  if (getCurrentInstructionSet() >= ARCV_SIMD_AVX2) {
+    switch (channelCount) {
+      case 2:
+        return interleaveAvx2<T, 2>(planes, pixelCount, pixels);
+
+      case 3:
+        return interleaveAvx2<T, 3>(planes, pixelCount, pixels);
+
+      case 4:
+        return interleaveAvx2<T, 4>(planes, pixelCount, pixels);
+
+      default:
+        break;
+    }
+  }
+#endif
+
+  interleaveReference(planes, pixelCount, channelCount, pixels);
+}
+
+template <typename TI, typename TA>
+void dispatchWeightedSums(const TI* input, TA* sums, std::size_t count, const std::ptrdiff_t* offsets,
+                          const TA* weights, std::size_t weightCount) {
+  switch (getCurrentInstructionSet()) {
+#ifdef ARCV_SIMD_X86
+    case ARCV_SIMD_AVX512:
+      computeWeightedSumsAvx512(input, sums, count, offsets, weights, weightCount);
+      break;
+
+    case ARCV_SIMD_AVX2:
+      computeWeightedSumsAvx2(input, sums, count, offsets, weights, weightCount);
+      break;
+
+    case ARCV_SIMD_SSE2:
+      computeWeightedSumsSse2(input, sums, count, offsets, weights, weightCount);
+      break;
+#endif
+
+    default:
+      computeWeightedSumsReference(input, sums, count, offsets, weights, weightCount);
+      break;
+  }
+}
+
+void dispatchFftStage(float* data, std::size_t sequenceSize, std::size_t rowStride, std::size_t batchSize, std::size_t halfLength,
+                      const float* twiddles) {
+  switch (getCurrentInstructionSet()) {
+#ifdef ARCV_SIMD_X86
+    case ARCV_SIMD_AVX512:
+      computeFftStageAvx512(data, sequenceSize, rowStride, batchSize, halfLength, twiddles);
+      break;
+
+    case ARCV_SIMD_AVX2:
+      computeFftStageAvx2(data, sequenceSize, rowStride, batchSize, halfLength, twiddles);
+      break;
+
+    case ARCV_SIMD_SSE2:
+      computeFftStageSse2(data, sequenceSize, rowStride, batchSize, halfLength, twiddles);
+      break;
+#endif
+
+    default:
+      computeFftStageReference(data, sequenceSize, rowStride, batchSize, halfLength, twiddles);
+      break;
+  }
+}
+
+void dispatchRecursiveFilterRow(const float* inputs, const float* const* previousRows, float* results, std::size_t count,
+                                const float* coefficients) {
+  switch (getCurrentInstructionSet()) {
+#ifdef ARCV_SIMD_X86
+    case ARCV_SIMD_AVX512:
+      computeRecursiveFilterRowAvx512(inputs, previousRows, results, count, coefficients);
+      break;
+
+    case ARCV_SIMD_AVX2:
+      computeRecursiveFilterRowAvx2(inputs, previousRows, results, count, coefficients);
+      break;
+
+    case ARCV_SIMD_SSE2:
+      computeRecursiveFilterRowSse2(inputs, previousRows, results, count, coefficients);
+      break;
+#endif
+
+    default:
+      computeRecursiveFilterRowReference(inputs, previousRows, results, count, coefficients);
+      break;
+  }
+}
+
+template <typename T>
+void dispatchMedians(const T* const* inputs, T* medians, std::size_t count, std::size_t inputCount) {
+  switch (getCurrentInstructionSet()) {
+#ifdef ARCV_SIMD_X86
+    case ARCV_SIMD_AVX512:
+      computeMediansAvx512(inputs, medians, count, inputCount);
+      break;
+
+    case ARCV_SIMD_AVX2:
+      computeMediansAvx2(inputs, medians, count, inputCount);
+      break;
+
+    case ARCV_SIMD_SSE2:
+      computeMediansSse2(inputs, medians, count, inputCount);
+      break;
+#endif
+
+    default:
+      computeMediansReference(inputs, medians, count, inputCount);
+      break;
+  }
+}
+
+template <bool IsMaximum, typename T>
+void dispatchExtrema(const T* lhs, const T* rhs, T* res, std::size_t count) {
+  switch (getCurrentInstructionSet()) {
+#ifdef ARCV_SIMD_X86
+    case ARCV_SIMD_AVX512:
+      computeExtremaAvx512<IsMaximum>(lhs, rhs, res, count);
+      break;
+
+    case ARCV_SIMD_AVX2:
+      computeExtremaAvx2<IsMaximum>(lhs, rhs, res, count);
+      break;
+
+    case ARCV_SIMD_SSE2:
+      computeExtremaSse2<IsMaximum>(lhs, rhs, res, count);
+      break;
+#endif
+
+    default:
+      computeExtremaReference<IsMaximum>(lhs, rhs, res, count);
+      break;
+  }
+}
+
+} // namespace
+
+SimdInstructionSet getInstructionSet() {
+  return getCurrentInstructionSet();
+}
+
+void setInstructionSet(SimdInstructionSet instructionSet) {
+  assert(("Error: Instruction set not supported by the CPU", instructionSet <= getSupportedInstructionSet()));
+
+  getCurrentInstructionSet() = instructionSet;
+}
+
+void computeFftStage(float* data, std::size_t sequenceSize, std::size_t rowStride, std::size_t batchSize, std::size_t halfLength,
+                     const float* twiddles) {
+  dispatchFftStage(data, sequenceSize, rowStride, batchSize, halfLength, twiddles);
+}
+
+void computeFftStageReference(float* data, std::size_t sequenceSize, std::size_t rowStride, std::size_t batchSize,
+                              std::size_t halfLength, const float* twiddles) {
+  forEachButterflyRows(data, sequenceSize, rowStride, halfLength, twiddles,
+                       [batchSize] (float* evenValues, float* oddValues, float twiddleReal, float twiddleImag) {
+    computeButterfliesReference(evenValues, oddValues, batchSize, twiddleReal, twiddleImag);
+  });
+}
+
+void computeRecursiveFilterRow(const float* inputs, const float* const* previousRows, float* results, std::size_t count,
+                               const float* coefficients) {
+  dispatchRecursiveFilterRow(inputs, previousRows, results, count, coefficients);
+}
+
+// Vectorized kernels repeat this loop for their remaining values rather than calling this function, whose instructions
+//  could be encoded differently
+void computeRecursiveFilterRowReference(const float* inputs, const float* const* previousRows, float* results, std::size_t count,
+                                        const float* coefficients) {
+  for (std::size_t i = 0; i < count; ++i) {
+    float value = inputs[i] * coefficients[0];
+    value += previousRows[0][i] * coefficients[1];
+    value += previousRows[1][i] * coefficients[2];
+    value += previousRows[2][i] * coefficients[3];
+
+    results[i] = value;
+  }
+}
+
+MedianNetwork getMedianNetwork(std::size_t valueCount) {
+  assert(("Error: Median networks only exist for 9 & 25 values", valueCount == 9 || valueCount == 25));
+
+  if (valueCount == 9)
+    return { median9Pairs, sizeof(median9Pairs) / sizeof(median9Pairs[0]) };
+  return { median25Pairs, sizeof(median25Pairs) / sizeof(median25Pairs[0]) };
+}
+
+template <>
+void applyElementwise<ARCV_ELEMENTWISE_ADD>(float* lhs, const float* rhs, std::size_t count) {
+  dispatchElementwise<ARCV_ELEMENTWISE_ADD>(lhs, rhs, count);
+}
+
+template <>
+void applyElementwise<ARCV_ELEMENTWISE_SUB>(float* lhs, const float* rhs, std::size_t count) {
+  dispatchElementwise<ARCV_ELEMENTWISE_SUB>(lhs, rhs, count);
+}
+
+template <>
+void applyElementwise<ARCV_ELEMENTWISE_MUL>(float* lhs, const float* rhs, std::size_t count) {
+  dispatchElementwise<ARCV_ELEMENTWISE_MUL>(lhs, rhs, count);
+}
+
+template <>
+void applyElementwise<ARCV_ELEMENTWISE_DIV>(float* lhs, const float* rhs, std::size_t count) {
+  dispatchElementwise<ARCV_ELEMENTWISE_DIV>(lhs, rhs, count);
+}
+
+template <>
+void applyElementwise<ARCV_ELEMENTWISE_ADD>(float* lhs, float val, std::size_t count) {
+  dispatchElementwise<ARCV_ELEMENTWISE_ADD>(lhs, val, count);
+}
+
+template <>
+void applyElementwise<ARCV_ELEMENTWISE_SUB>(float* lhs, float val, std::size_t count) {
+  dispatchElementwise<ARCV_ELEMENTWISE_SUB>(lhs, val, count);
+}
+
+template <>
+void applyElementwise<ARCV_ELEMENTWISE_MUL>(float* lhs, float val, std::size_t count) {
+  dispatchElementwise<ARCV_ELEMENTWISE_MUL>(lhs, val, count);
+}
+
+template <>
+void applyElementwise<ARCV_ELEMENTWISE_DIV>(float* lhs, float val, std::size_t count) {
+  dispatchElementwise<ARCV_ELEMENTWISE_DIV>(lhs, val, count);
+}
+
+template <>
+void applyElementwise<ARCV_ELEMENTWISE_ADD>(uint8_t* lhs, const uint8_t* rhs, std::size_t count) {
+  dispatchElementwise<ARCV_ELEMENTWISE_ADD>(lhs, rhs, count);
+}
+
+template <>
+void applyElementwise<ARCV_ELEMENTWISE_SUB>(uint8_t* lhs, const uint8_t* rhs, std::size_t count) {
+  dispatchElementwise<ARCV_ELEMENTWISE_SUB>(lhs, rhs, count);
+}
+
+template <>
+void applyElementwise<ARCV_ELEMENTWISE_MUL>(uint8_t* lhs, const uint8_t* rhs, std::size_t count) {
+  dispatchElementwise<ARCV_ELEMENTWISE_MUL>(lhs, rhs, count);
+}
+
+template <>
+void applyElementwise<ARCV_ELEMENTWISE_DIV>(uint8_t* lhs, const uint8_t* rhs, std::size_t count) {
+  dispatchElementwise<ARCV_ELEMENTWISE_DIV>(lhs, rhs, count);
+}
+
+template <>
+void applyElementwise<ARCV_ELEMENTWISE_ADD>(uint8_t* lhs, float val, std::size_t count) {
+  dispatchElementwise<ARCV_ELEMENTWISE_ADD>(lhs, val, count);
+}
+
+template <>
+void applyElementwise<ARCV_ELEMENTWISE_SUB>(uint8_t* lhs, float val, std::size_t count) {
+  dispatchElementwise<ARCV_ELEMENTWISE_SUB>(lhs, val, count);
+}
+
+template <>
+void applyElementwise<ARCV_ELEMENTWISE_MUL>(uint8_t* lhs, float val, std::size_t count) {
+  dispatchElementwise<ARCV_ELEMENTWISE_MUL>(lhs, val, count);
+}
+
+template <>
+void applyElementwise<ARCV_ELEMENTWISE_DIV>(uint8_t* lhs, float val, std::size_t count) {
+  dispatchElementwise<ARCV_ELEMENTWISE_DIV>(lhs, val, count);
+}
+
+// Statistics only have an AVX2 kernel, which AVX-512 CPUs also run
+template <>
+void accumulateStatistics(const float* pixels, std::size_t pixelCount, uint8_t channelCount, const double* shifts,
+                          float* mins, float* maxs, double* sums, double* squaredSums) {
+#ifdef ARCV_SIMD_X86
+  if (getCurrentInstructionSet() >= ARCV_SIMD_AVX2) {
+    switch (channelCount) {
+      case 1:
+        return accumulateStatisticsAvx2<1>(pixels, pixelCount, shifts, mins, maxs, sums, squaredSums);
+
+      case 2:
+        return accumulateStatisticsAvx2<2>(pixels, pixelCount, shifts, mins, maxs, sums, squaredSums);
+
+      case 3:
+        return accumulateStatisticsAvx2<3>(pixels, pixelCount, shifts, mins, maxs, sums, squaredSums);
+
+      case 4:
+        return accumulateStatisticsAvx2<4>(pixels, pixelCount, shifts, mins, maxs, sums, squaredSums);
+
+      default:
+        break;
+    }
+  }
+#endif
+
+  accumulateStatisticsReference(pixels, pixelCount, channelCount, shifts, mins, maxs, sums, squaredSums);
+}
+
+template <>
+void convert(const uint8_t* input, uint8_t* output, std::size_t count, float scale, float offset) {
+  dispatchConversion(input, output, count, scale, offset);
+}
+
+template <>
+void convert(const uint8_t* input, int16_t* output, std::size_t count, float scale, float offset) {
+  dispatchConversion(input, output, count, scale, offset);
+}
+
+template <>
+void convert(const uint8_t* input, float* output, std::size_t count, float scale, float offset) {
+  dispatchConversion(input, output, count, scale, offset);
+}
+
+template <>
+void convert(const int16_t* input, uint8_t* output, std::size_t count, float scale, float offset) {
+  dispatchConversion(input, output, count, scale, offset);
+}
+
+template <>
+void convert(const int16_t* input, int16_t* output, std::size_t count, float scale, float offset) {
+  dispatchConversion(input, output, count, scale, offset);
+}
+
+template <>
+void convert(const int16_t* input, float* output, std::size_t count, float scale, float offset) {
+  dispatchConversion(input, output, count, scale, offset);
+}
+
+template <>
+void convert(const float* input, uint8_t* output, std::size_t count, float scale, float offset) {
+  dispatchConversion(input, output, count, scale, offset);
+}
+
+template <>
+void convert(const float* input, int16_t* output, std::size_t count, float scale, float offset) {
+  dispatchConversion(input, output, count, scale, offset);
+}
+
+template <>
+void convert(const float* input, float* output, std::size_t count, float scale, float offset) {
+  dispatchConversion(input, output, count, scale, offset);
+}
+
+template <>
+void deinterleave(const uint8_t* pixels, std::size_t pixelCount, uint8_t channelCount, uint8_t* const* planes) {
+  dispatchDeinterleaving(pixels, pixelCount, channelCount, planes);
+}
+
+template <>
+void deinterleave(const int16_t* pixels, std::size_t pixelCount, uint8_t channelCount, int16_t* const* planes) {
+  dispatchDeinterleaving(pixels, pixelCount, channelCount, planes);
+}
+
+template <>
+void deinterleave(const float* pixels, std::size_t pixelCount, uint8_t channelCount, float* const* planes) {
+  dispatchDeinterleaving(pixels, pixelCount, channelCount, planes);
+}
+
+template <>
+void interleave(const uint8_t* const* planes, std::size_t pixelCount, uint8_t channelCount, uint8_t* pixels) {
+  dispatchInterleaving(planes, pixelCount, channelCount, pixels);
+}
+
+template <>
+void interleave(const int16_t* const* planes, std::size_t pixelCount, uint8_t channelCount, int16_t* pixels) {
+  dispatchInterleaving(planes, pixelCount, channelCount, pixels);
+}
+
+template <>
+void interleave(const float* const* planes, std::size_t pixelCount, uint8_t channelCount, float* pixels) {
+  dispatchInterleaving(planes, pixelCount, channelCount, pixels);
+}
+
+template <>
+void computeWeightedSums(const float* input, float* sums, std::size_t count, const std::ptrdiff_t* offsets,
+                         const float* weights, std::size_t weightCount) {
+  dispatchWeightedSums(input, sums, count, offsets, weights, weightCount);
+}
+
+template <>
+void computeWeightedSums(const uint8_t* input, int32_t* sums, std::size_t count, const std::ptrdiff_t* offsets,
+                         const int32_t* weights, std::size_t weightCount) {
+  dispatchWeightedSums(input, sums, count, offsets, weights, weightCount);
+}
+
+template <>
+void computeWeightedSums(const int16_t* input, int32_t* sums, std::size_t count, const std::ptrdiff_t* offsets,
+                         const int32_t* weights, std::size_t weightCount) {
+  dispatchWeightedSums(input, sums, count, offsets, weights, weightCount);
+}
+
+template <>
+void computeWeightedSums(const int32_t* input, int32_t* sums, std::size_t count, const std::ptrdiff_t* offsets,
+                         const int32_t* weights, std::size_t weightCount) {
+  dispatchWeightedSums(input, sums, count, offsets, weights, weightCount);
+}
+
+template <>
+void computeMedians(const uint8_t* const* inputs, uint8_t* medians, std::size_t count, std::size_t inputCount) {
+  dispatchMedians(inputs, medians, count, inputCount);
+}
+
+template <>
+void computeMedians(const int16_t* const* inputs, int16_t* medians, std::size_t count, std::size_t inputCount) {
+  dispatchMedians(inputs, medians, count, inputCount);
+}
+
+template <>
+void computeMedians(const float* const* inputs, float* medians, std::size_t count, std::size_t inputCount) {
+  dispatchMedians(inputs, medians, count, inputCount);
+}
+
+template <>
+void computeMinimums(const uint8_t* lhs, const uint8_t* rhs, uint8_t* res, std::size_t count) {
+  dispatchExtrema<false>(lhs, rhs, res, count);
+}
+
+template <>
+void computeMinimums(const int16_t* lhs, const int16_t* rhs, int16_t* res, std::size_t count) {
+  dispatchExtrema<false>(lhs, rhs, res, count);
+}
+
+template <>
+void computeMinimums(const float* lhs, const float* rhs, float* res, std::size_t count) {
+  dispatchExtrema<false>(lhs, rhs, res, count);
+}
+
+template <>
+void computeMaximums(const uint8_t* lhs, const uint8_t* rhs, uint8_t* res, std::size_t count) {
+  dispatchExtrema<true>(lhs, rhs, res, count);
+}
+
+template <>
+void computeMaximums(const int16_t* lhs, const int16_t* rhs, int16_t* res, std::size_t count) {
+  dispatchExtrema<true>(lhs, rhs, res, count);
+}
+
+template <>
+void computeMaximums(const float* lhs, const float* rhs, float* res, std::size_t count) {
+  dispatchExtrema<true>(lhs, rhs, res, count);
+}
+
+} // namespace Simd
+
+} // namespace Arcv
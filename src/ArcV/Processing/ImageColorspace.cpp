@@ -6,141 +6,285 @@ namespace Image {
 
 namespace {
 
-void addAlphaChannel(Matrix<>& mat) {
-  const Matrix<float> tempMat = mat;
+template <Colorspace C> using ColorspaceTag = std::integral_constant<Colorspace, C>;
 
-  mat.setChannelCount(static_cast<uint8_t>(mat.getChannelCount() + 1));
-  mat.getData().resize(mat.getWidth() * mat.getHeight() * mat.getChannelCount());
+// Integer pixels are summed as 32-bit integers, & averaged to the nearest value
+template <typename T> using ChannelSum = std::conditional_t<std::is_integral<T>::value, int32_t, T>;
 
-  for (std::size_t i = 0, delta = 0; i < tempMat.getData().size(); i += tempMat.getChannelCount(), ++delta) {
-    for (std::size_t chan = i; chan < i + tempMat.getChannelCount(); ++chan)
-      mat.getData()[chan + delta] = tempMat.getData()[chan];
+template <typename T>
+T computeAverage(ChannelSum<T> sum, uint8_t channelCount, std::false_type) {
+  return sum / channelCount;
+}
 
-    // Filling the alpha value with full opacity by default
-    mat.getData()[i + tempMat.getChannelCount() + delta] = 255;
-  }
+template <typename T>
+T computeAverage(ChannelSum<T> sum, uint8_t channelCount, std::true_type) {
+  return static_cast<T>((sum + channelCount / 2) / channelCount);
 }
 
-void removeAlphaChannel(Matrix<>& mat) {
-  // No need to start at the very beginning since the first channel pack will not be moved
-  for (std::size_t i = mat.getChannelCount(), delta = 1; i < mat.getData().size(); i += mat.getChannelCount(), ++delta) {
-    for (std::size_t chan = i; chan < i + mat.getChannelCount() - 1; ++chan)
-      mat.getData()[chan - delta] = mat.getData()[chan];
-  }
+// Rounds to the nearest integer, halves going away from zero; the denominator must be positive
+int32_t divideRounded(int32_t numerator, int32_t denominator) {
+  return (numerator >= 0 ? (numerator + denominator / 2) / denominator : -((denominator / 2 - numerator) / denominator));
+}
+
+// Hue is given in half degrees, so that it fits in 8 bits; saturation & value go from 0 to 255
+// Branches are replaced by selects, for rows of planar pixels to be vectorized; every hue but the red one being positive,
+//  wrapping negative ones around applies to the red one only
+template <typename T>
+void computeHsv(T red, T green, T blue, T& hue, T& saturation, T& value, std::false_type) {
+  red /= 255;
+  green /= 255;
+  blue /= 255;
+
+  const T minVal = std::min(std::min(red, green), blue);
+  const T maxVal = std::max(std::max(red, green), blue);
+  const T delta = maxVal - minVal;
+
+  // Hue
+  const T hueDiff = (maxVal == red ? green - blue : (maxVal == green ? blue - red : red - green));
+  const T hueBase = (maxVal == red ? 0 : (maxVal == green ? 120 : 240));
+  T hueDegrees = hueBase + 60 * hueDiff / (delta == 0 ? 1 : delta);
+  hueDegrees = (hueDegrees < 0 ? hueDegrees + 360 : hueDegrees);
 
-  mat.setChannelCount(static_cast<uint8_t>(mat.getChannelCount() - 1));
-  mat.getData().resize(mat.getWidth() * mat.getHeight() * mat.getChannelCount());
+  hue = (delta == 0 ? 0 : hueDegrees / 2);
+
+  // Saturation
+  saturation = (maxVal == 0 ? 0 : delta / maxVal * 255);
+
+  // Value
+  value = maxVal * 255;
 }
 
-} // namespace
+// Same computations in fixed point, every division being rounded to the nearest integer
+template <typename T>
+void computeHsv(T red, T green, T blue, T& hue, T& saturation, T& value, std::true_type) {
+  const int32_t minVal = std::min(std::min<int32_t>(red, green), static_cast<int32_t>(blue));
+  const int32_t maxVal = std::max(std::max<int32_t>(red, green), static_cast<int32_t>(blue));
+  const int32_t delta = maxVal - minVal;
 
-template <>
-Matrix<> changeColorspace<ARCV_COLORSPACE_GRAY>(Matrix<> mat) {
-  std::size_t index = 0;
-  // Avoiding alpha channel, not including it into the operation
-  const uint8_t alpha = static_cast<uint8_t>(mat.getColorspace() >= ARCV_COLORSPACE_GRAY_ALPHA ? 1 : 0);
-  const uint8_t stride = mat.getChannelCount() - alpha;
+  // Hue
+  int32_t hueVal = 0;
 
-  for (auto elt = mat.getData().begin(); elt != mat.getData().end(); elt += mat.getChannelCount(), index += 1 + alpha) {
-    mat.getData()[index] = std::accumulate(elt, elt + stride, 0.f) / stride;
+  if (delta != 0) {
+    if (maxVal == red) {
+      hueVal = divideRounded(30 * (green - blue), delta);
 
-    if (alpha)
-      mat.getData()[index + 1] = *(elt + stride);
+      if (hueVal < 0)
+        hueVal += 180;
+    } else if (maxVal == green) {
+      hueVal = 60 + divideRounded(30 * (blue - red), delta);
+    } else {
+      hueVal = 120 + divideRounded(30 * (red - green), delta);
+    }
   }
 
-  mat.setChannelCount(static_cast<uint8_t>(1 + alpha));
-  mat.getData().resize(mat.getWidth() * mat.getHeight() * mat.getChannelCount());
+  hue = static_cast<T>(hueVal);
 
-  if (mat.getColorspace() >= ARCV_COLORSPACE_GRAY_ALPHA)
-    removeAlphaChannel(mat);
-  mat.setColorspace(ARCV_COLORSPACE_GRAY);
+  // Saturation
+  saturation = static_cast<T>(maxVal <= 0 ? 0 : divideRounded(delta * 255, maxVal));
 
-  return mat;
+  // Value
+  value = static_cast<T>(maxVal);
 }
 
-template <>
-Matrix<> changeColorspace<ARCV_COLORSPACE_RGB>(Matrix<> mat) {
+// Converts each pixel of 'mat' into 'res' through 'convertPixel', which receives pointers on both pixels' first channel
+//  and must read its input entirely before writing; 'res' can be 'mat' itself if the channel count does not increase,
+//  since pixels are then only ever moved backwards; both pixel sizes being constant, the conversion gets unrolled on them
+template <uint8_t ResChannelCount, typename T, typename PixelFunc>
+void convertPixels(const Matrix<T>& mat, Matrix<T>& res, Colorspace resColorspace, PixelFunc convertPixel) {
+  const std::size_t width = mat.getWidth();
+  const std::size_t height = mat.getHeight();
+  const std::size_t matStride = mat.getStride();
+  const uint8_t matChannelCount = mat.getChannelCount();
+  const bool inPlace = (&res == &mat);
+
+  assert(("Error: Channels cannot be added in place", !inPlace || ResChannelCount <= matChannelCount));
+
+  // Shrinking in place must be done after the conversion, the memory to read being otherwise released
+  if (inPlace)
+    res.setChannelCount(ResChannelCount);
+  else
+    res.reshape(width, height, ResChannelCount, mat.getImgBitDepth(), resColorspace, mat.hasPaddedRows());
+
+  const T* matData = mat.getData().data();
+  T* resData = res.getData().data();
+
+  dispatchChannelCount(matChannelCount, [&] (auto matChannels) {
+    const uint8_t matPixelSize = matChannels(matChannelCount);
+
+    for (std::size_t heightIndex = 0; heightIndex < height; ++heightIndex) {
+      const T* matPixel = matData + heightIndex * matStride;
+      T* resPixel = resData + heightIndex * res.getStride();
+
+      for (std::size_t widthIndex = 0; widthIndex < width; ++widthIndex, matPixel += matPixelSize, resPixel += ResChannelCount)
+        convertPixel(matPixel, resPixel);
+    }
+  });
+
+  res.reshape(width, height, ResChannelCount, res.getImgBitDepth(), resColorspace, res.hasPaddedRows());
+}
+
+template <typename T>
+void convertColorspace(const Matrix<T>& mat, Matrix<T>& res, ColorspaceTag<ARCV_COLORSPACE_GRAY>) {
+  // Avoiding alpha channel, not including it into the operation
+  const uint8_t alpha = static_cast<uint8_t>(mat.getColorspace() >= ARCV_COLORSPACE_GRAY_ALPHA ? 1 : 0);
+  const uint8_t colorChannelCount = mat.getChannelCount() - alpha;
+
+  convertPixels<1>(mat, res, ARCV_COLORSPACE_GRAY, [colorChannelCount] (const T* matPixel, T* resPixel) {
+    *resPixel = computeAverage<T>(std::accumulate(matPixel, matPixel + colorChannelCount, ChannelSum<T>(0)), colorChannelCount,
+                                  std::is_integral<T>());
+  });
+}
+
+template <typename T>
+void convertColorspace(const Matrix<T>& mat, Matrix<T>& res, ColorspaceTag<ARCV_COLORSPACE_RGB>) {
   assert(("Warning: Function not handled yet",
           mat.getColorspace() == ARCV_COLORSPACE_RGBA || mat.getColorspace() == ARCV_COLORSPACE_RGB));
 
-  if (mat.getColorspace() >= ARCV_COLORSPACE_GRAY_ALPHA)
-    removeAlphaChannel(mat);
-  mat.setColorspace(ARCV_COLORSPACE_RGB);
-
-  return mat;
+  convertPixels<3>(mat, res, ARCV_COLORSPACE_RGB, [] (const T* matPixel, T* resPixel) {
+    for (uint8_t chan = 0; chan < 3; ++chan)
+      resPixel[chan] = matPixel[chan];
+  });
 }
 
-template <>
-Matrix<> changeColorspace<ARCV_COLORSPACE_HSV>(Matrix<> mat) {
+template <typename T>
+void convertColorspace(const Matrix<T>& mat, Matrix<T>& res, ColorspaceTag<ARCV_COLORSPACE_HSV>) {
   assert(("Error: Input matrix's colorspace should be RGB(A)",
           mat.getColorspace() == ARCV_COLORSPACE_RGB || mat.getColorspace() == ARCV_COLORSPACE_RGBA));
 
-  for (auto elt = mat.getData().begin(); elt != mat.getData().end(); elt += mat.getChannelCount()) {
-    const float red = *elt / 255;
-    const float green = *(elt + 1) / 255;
-    const float blue = *(elt + 2) / 255;
+  convertPixels<3>(mat, res, ARCV_COLORSPACE_HSV, [] (const T* matPixel, T* resPixel) {
+    computeHsv(matPixel[0], matPixel[1], matPixel[2], resPixel[0], resPixel[1], resPixel[2], std::is_integral<T>());
+  });
+}
 
-    const float minVal = std::min(std::min(red, green), blue);
-    const float maxVal = std::max(std::max(red, green), blue);
-    const float delta = maxVal - minVal;
+template <typename T>
+void convertColorspace(const Matrix<T>& mat, Matrix<T>& res, ColorspaceTag<ARCV_COLORSPACE_GRAY_ALPHA>) {
+  const uint8_t alpha = static_cast<uint8_t>(mat.getColorspace() >= ARCV_COLORSPACE_GRAY_ALPHA ? 1 : 0);
+  const uint8_t colorChannelCount = mat.getChannelCount() - alpha;
 
-    // Hue
-    float hue = 0.f;
+  convertPixels<2>(mat, res, ARCV_COLORSPACE_GRAY_ALPHA, [colorChannelCount] (const T* matPixel, T* resPixel) {
+    const T gray = computeAverage<T>(std::accumulate(matPixel, matPixel + colorChannelCount, ChannelSum<T>(0)), colorChannelCount,
+                                     std::is_integral<T>());
 
-    if (delta == 0) {
-      *elt = 0;
-    } else {
-      if (maxVal == red) {
-        hue = 60 * (green - blue) / delta;
-
-        if (hue < 0.f)
-          hue += 360;
-      } else if (maxVal == green) {
-        hue = 120 + 60 * (blue - red) / delta;
-      } else if (maxVal == blue) {
-        hue = 240 + 60 * (red - green) / delta;
-      }
-
-      *elt = hue / 2;
-    }
+    resPixel[0] = gray;
+    // Filling the alpha value with full opacity by default
+    resPixel[1] = 255;
+  });
+}
 
-    // Saturation
-    *(elt + 1) = (maxVal == 0 ? 0 : delta / maxVal * 255);
+template <typename T>
+void convertColorspace(const Matrix<T>& mat, Matrix<T>& res, ColorspaceTag<ARCV_COLORSPACE_RGBA>) {
+  assert(("Warning: Function not handled yet",
+          mat.getColorspace() == ARCV_COLORSPACE_RGB || mat.getColorspace() == ARCV_COLORSPACE_RGBA));
 
-    // Value
-    *(elt + 2) = maxVal * 255;
-  }
+  const bool hasAlpha = (mat.getColorspace() >= ARCV_COLORSPACE_GRAY_ALPHA);
 
-  if (mat.getColorspace() >= ARCV_COLORSPACE_GRAY_ALPHA)
-    removeAlphaChannel(mat);
-  mat.setColorspace(ARCV_COLORSPACE_HSV);
+  convertPixels<4>(mat, res, ARCV_COLORSPACE_RGBA, [hasAlpha] (const T* matPixel, T* resPixel) {
+    const T alpha = (hasAlpha ? matPixel[3] : 255);
 
-  return mat;
+    for (uint8_t chan = 0; chan < 3; ++chan)
+      resPixel[chan] = matPixel[chan];
+    // Filling the alpha value with full opacity by default
+    resPixel[3] = alpha;
+  });
 }
 
-template <>
-Matrix<> changeColorspace<ARCV_COLORSPACE_GRAY_ALPHA>(Matrix<> mat) {
-  mat = changeColorspace<ARCV_COLORSPACE_GRAY>(mat);
+// Planar conversions process whole rows of each plane at once; in place, the result's planes begin where the input's do
+template <typename T>
+void convertColorspace(const PlanarMatrix<T>& mat, PlanarMatrix<T>& res, ColorspaceTag<ARCV_COLORSPACE_GRAY>) {
+  const std::size_t width = mat.getWidth();
+  const std::size_t height = mat.getHeight();
+  const uint8_t alpha = static_cast<uint8_t>(mat.getColorspace() >= ARCV_COLORSPACE_GRAY_ALPHA ? 1 : 0);
+  const uint8_t colorChannelCount = mat.getChannelCount() - alpha;
+  const bool inPlace = (&res == &mat);
+
+  if (!inPlace)
+    res.reshape(width, height, 1, mat.getImgBitDepth(), ARCV_COLORSPACE_GRAY, mat.hasPaddedRows());
 
-  if (mat.getColorspace() < ARCV_COLORSPACE_GRAY_ALPHA)
-    addAlphaChannel(mat);
-  mat.setColorspace(ARCV_COLORSPACE_GRAY_ALPHA);
+  std::vector<ChannelSum<T>> sums(width);
+
+  for (std::size_t heightIndex = 0; heightIndex < height; ++heightIndex) {
+    std::fill(sums.begin(), sums.end(), ChannelSum<T>(0));
+
+    for (uint8_t chan = 0; chan < colorChannelCount; ++chan) {
+      const T* matRow = mat.getPlane(chan).getRow(heightIndex);
+
+      for (std::size_t widthIndex = 0; widthIndex < width; ++widthIndex)
+        sums[widthIndex] += matRow[widthIndex];
+    }
+
+    T* resRow = res.getPlane(0).getRow(heightIndex);
+
+    for (std::size_t widthIndex = 0; widthIndex < width; ++widthIndex)
+      resRow[widthIndex] = computeAverage<T>(sums[widthIndex], colorChannelCount, std::is_integral<T>());
+  }
 
-  return mat;
+  // Shrinking in place must be done after the conversion, the memory to read being otherwise released
+  res.reshape(width, height, 1, res.getImgBitDepth(), ARCV_COLORSPACE_GRAY, res.hasPaddedRows());
 }
 
-template <>
-Matrix<> changeColorspace<ARCV_COLORSPACE_RGBA>(Matrix<> mat) {
-  assert(("Warning: Function not handled yet",
+template <typename T>
+void convertColorspace(const PlanarMatrix<T>& mat, PlanarMatrix<T>& res, ColorspaceTag<ARCV_COLORSPACE_HSV>) {
+  assert(("Error: Input matrix's colorspace should be RGB(A)",
           mat.getColorspace() == ARCV_COLORSPACE_RGB || mat.getColorspace() == ARCV_COLORSPACE_RGBA));
 
-  if (mat.getColorspace() < ARCV_COLORSPACE_GRAY_ALPHA)
-    addAlphaChannel(mat);
-  mat.setColorspace(ARCV_COLORSPACE_RGBA);
+  const std::size_t width = mat.getWidth();
+  const std::size_t height = mat.getHeight();
+  const bool inPlace = (&res == &mat);
+
+  if (!inPlace)
+    res.reshape(width, height, 3, mat.getImgBitDepth(), ARCV_COLORSPACE_HSV, mat.hasPaddedRows());
+
+  for (std::size_t heightIndex = 0; heightIndex < height; ++heightIndex) {
+    const T* redRow = mat.getPlane(0).getRow(heightIndex);
+    const T* greenRow = mat.getPlane(1).getRow(heightIndex);
+    const T* blueRow = mat.getPlane(2).getRow(heightIndex);
+    T* hueRow = res.getPlane(0).getRow(heightIndex);
+    T* saturationRow = res.getPlane(1).getRow(heightIndex);
+    T* valueRow = res.getPlane(2).getRow(heightIndex);
+
+    for (std::size_t widthIndex = 0; widthIndex < width; ++widthIndex) {
+      computeHsv(redRow[widthIndex], greenRow[widthIndex], blueRow[widthIndex],
+                 hueRow[widthIndex], saturationRow[widthIndex], valueRow[widthIndex], std::is_integral<T>());
+    }
+  }
+
+  res.reshape(width, height, 3, res.getImgBitDepth(), ARCV_COLORSPACE_HSV, res.hasPaddedRows());
+}
+
+} // namespace
 
-  return mat;
+template <Colorspace C, typename T>
+void changeColorspace(const Matrix<T>& mat, Matrix<T>& res) {
+  convertColorspace(mat, res, ColorspaceTag<C>());
 }
 
+template <Colorspace C, typename T>
+void changeColorspace(const PlanarMatrix<T>& mat, PlanarMatrix<T>& res) {
+  convertColorspace(mat, res, ColorspaceTag<C>());
+}
+
+template void changeColorspace<ARCV_COLORSPACE_GRAY>(const Matrix<float>& mat, Matrix<float>& res);
+template void changeColorspace<ARCV_COLORSPACE_GRAY>(const Matrix<uint8_t>& mat, Matrix<uint8_t>& res);
+template void changeColorspace<ARCV_COLORSPACE_GRAY>(const Matrix<int16_t>& mat, Matrix<int16_t>& res);
+template void changeColorspace<ARCV_COLORSPACE_RGB>(const Matrix<float>& mat, Matrix<float>& res);
+template void changeColorspace<ARCV_COLORSPACE_RGB>(const Matrix<uint8_t>& mat, Matrix<uint8_t>& res);
+template void changeColorspace<ARCV_COLORSPACE_RGB>(const Matrix<int16_t>& mat, Matrix<int16_t>& res);
+template void changeColorspace<ARCV_COLORSPACE_HSV>(const Matrix<float>& mat, Matrix<float>& res);
+template void changeColorspace<ARCV_COLORSPACE_HSV>(const Matrix<uint8_t>& mat, Matrix<uint8_t>& res);
+template void changeColorspace<ARCV_COLORSPACE_HSV>(const Matrix<int16_t>& mat, Matrix<int16_t>& res);
+template void changeColorspace<ARCV_COLORSPACE_GRAY_ALPHA>(const Matrix<float>& mat, Matrix<float>& res);
+template void changeColorspace<ARCV_COLORSPACE_GRAY_ALPHA>(const Matrix<uint8_t>& mat, Matrix<uint8_t>& res);
+template void changeColorspace<ARCV_COLORSPACE_GRAY_ALPHA>(const Matrix<int16_t>& mat, Matrix<int16_t>& res);
+template void changeColorspace<ARCV_COLORSPACE_RGBA>(const Matrix<float>& mat, Matrix<float>& res);
+template void changeColorspace<ARCV_COLORSPACE_RGBA>(const Matrix<uint8_t>& mat, Matrix<uint8_t>& res);
+template void changeColorspace<ARCV_COLORSPACE_RGBA>(const Matrix<int16_t>& mat, Matrix<int16_t>& res);
+template void changeColorspace<ARCV_COLORSPACE_GRAY>(const PlanarMatrix<float>& mat, PlanarMatrix<float>& res);
+template void changeColorspace<ARCV_COLORSPACE_GRAY>(const PlanarMatrix<uint8_t>& mat, PlanarMatrix<uint8_t>& res);
+template void changeColorspace<ARCV_COLORSPACE_GRAY>(const PlanarMatrix<int16_t>& mat, PlanarMatrix<int16_t>& res);
+template void changeColorspace<ARCV_COLORSPACE_HSV>(const PlanarMatrix<float>& mat, PlanarMatrix<float>& res);
+template void changeColorspace<ARCV_COLORSPACE_HSV>(const PlanarMatrix<uint8_t>& mat, PlanarMatrix<uint8_t>& res);
+template void changeColorspace<ARCV_COLORSPACE_HSV>(const PlanarMatrix<int16_t>& mat, PlanarMatrix<int16_t>& res);
+
 } // namespace Image
 
 } // namespace Arcv
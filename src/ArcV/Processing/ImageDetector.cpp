@@ -1,3 +1,7 @@
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
 #include "ArcV/Processing/Image.hpp"
 #include "ArcV/Processing/Sobel.hpp"
 
@@ -5,72 +9,273 @@ namespace Arcv {
 
 namespace Image {
 
-template <>
-Matrix<> applyDetector<ARCV_DETECTOR_TYPE_CANNY>(const Matrix<>& mat) {
-  const Sobel sobel(applyFilter<ARCV_FILTER_TYPE_GAUSSIAN_BLUR>(changeColorspace<ARCV_COLORSPACE_GRAY>(mat)));
-  const Matrix<> directionMat = sobel.computeGradientDirection();
-  Matrix<> res = sobel.getSobelMat();
-
-  for (std::size_t heightIndex = 1; heightIndex < sobel.getSobelMat().getHeight() - 1; ++heightIndex) {
-    for (std::size_t widthIndex = 1; widthIndex < sobel.getSobelMat().getWidth() - 1; ++widthIndex) {
-      const std::size_t matIndex = heightIndex * sobel.getSobelMat().getWidth() + widthIndex;
-      const std::size_t upPixIndex = (heightIndex - 1) * sobel.getSobelMat().getWidth() + widthIndex;
-      const std::size_t lowPixIndex = (heightIndex + 1) * sobel.getSobelMat().getWidth() + widthIndex;
-      const std::size_t rightPixIndex = heightIndex * sobel.getSobelMat().getWidth() + widthIndex + 1;
-      const std::size_t leftPixIndex = heightIndex * sobel.getSobelMat().getWidth() + widthIndex - 1;
-      const std::size_t upperRightPixIndex = (heightIndex - 1) * sobel.getSobelMat().getWidth() + widthIndex + 1;
-      const std::size_t upperLeftPixIndex = (heightIndex - 1) * sobel.getSobelMat().getWidth() + widthIndex - 1;
-      const std::size_t lowerRightPixIndex = (heightIndex + 1) * sobel.getSobelMat().getWidth() + widthIndex + 1;
-      const std::size_t lowerLeftPixIndex = (heightIndex + 1) * sobel.getSobelMat().getWidth() + widthIndex - 1;
-
-      if ((directionMat[matIndex] >= 0.f && directionMat[matIndex] <= 22.5f)
-          || (directionMat[matIndex] >= 157.5f && directionMat[matIndex] <= 202.5f)
-          || (directionMat[matIndex] >= 337.5f && directionMat[matIndex] <= 360.f)) {
-        if (sobel.getSobelMat()[rightPixIndex] > sobel.getSobelMat()[matIndex]
-            || sobel.getSobelMat()[leftPixIndex] > sobel.getSobelMat()[matIndex])
-          res[matIndex] = 0.f;
-      } else if ((directionMat[matIndex] > 22.5f && directionMat[matIndex] <= 67.5f)
-                 || (directionMat[matIndex] > 202.5f && directionMat[matIndex] <= 247.5f)) {
-        if (sobel.getSobelMat()[lowerRightPixIndex] > sobel.getSobelMat()[matIndex]
-            || sobel.getSobelMat()[upperLeftPixIndex] > sobel.getSobelMat()[matIndex])
-          res[matIndex] = 0.f;
-      } else if ((directionMat[matIndex] > 67.5f && directionMat[matIndex] <= 112.5f)
-                 || (directionMat[matIndex] > 247.5f && directionMat[matIndex] <= 292.5f)) {
-        if (sobel.getSobelMat()[upPixIndex] > sobel.getSobelMat()[matIndex]
-            || sobel.getSobelMat()[lowPixIndex] > sobel.getSobelMat()[matIndex])
-          res[matIndex] = 0.f;
-      } else if ((directionMat[matIndex] > 112.5f && directionMat[matIndex] <= 157.5f)
-                 || (directionMat[matIndex] > 292.5f && directionMat[matIndex] <= 337.5f)) {
-        if (sobel.getSobelMat()[upperRightPixIndex] > sobel.getSobelMat()[matIndex]
-            || sobel.getSobelMat()[lowerLeftPixIndex] > sobel.getSobelMat()[matIndex])
-          res[matIndex] = 0.f;
+namespace {
+
+template <DetectorType D> using DetectorTag = std::integral_constant<DetectorType, D>;
+
+// Edges found on gradients of another type than the image's are converted afterwards
+template <typename T>
+void thresholdEdges(const Matrix<T>& suppressedMat, Matrix<T>& res) {
+  threshold<ARCV_THRESH_TYPE_HYSTERESIS_AUTO>(suppressedMat, res);
+}
+
+template <typename TG, typename T>
+void thresholdEdges(const Matrix<TG>& suppressedMat, Matrix<T>& res) {
+  Matrix<TG> edgesMat(AlignedAllocator<TG>(MemoryArena::getCurrent()));
+  threshold<ARCV_THRESH_TYPE_HYSTERESIS_AUTO>(suppressedMat, edgesMat);
+
+  res.convertFrom(edgesMat);
+}
+
+// Gradients' directions, quantized to the axis along which non-maxima are suppressed
+enum CannyDirection : uint8_t { CANNY_DIRECTION_HORIZONTAL = 0,
+                                CANNY_DIRECTION_DIAGONAL,             // Both gradients of the same sign, down-right
+                                CANNY_DIRECTION_VERTICAL,
+                                CANNY_DIRECTION_ANTIDIAGONAL };       // Gradients of opposite signs, up-right
+
+// Sectors are bounded by the slopes tan(22.5°) & tan(67.5°), to which the vertical gradient is compared without any
+//  arctangent; integer gradients are compared in fixed point, scaled by 2^15, which their products keep within 32 bits
+inline CannyDirection quantizeDirection(int16_t horizGrad, int16_t vertGrad) {
+  constexpr uint32_t lowerSlope = 13573;  // tan(22.5°) * 2^15
+  constexpr uint32_t upperSlope = 79109;  // tan(67.5°) * 2^15
+
+  const uint32_t horizAbs = static_cast<uint32_t>(std::abs(horizGrad));
+  const uint32_t scaledVertAbs = static_cast<uint32_t>(std::abs(vertGrad)) << 15;
+
+  // Selected without branching, directions of neighbouring elements being hardly predictable
+  const CannyDirection diagonal = ((horizGrad ^ vertGrad) >= 0 ? CANNY_DIRECTION_DIAGONAL : CANNY_DIRECTION_ANTIDIAGONAL);
+  const CannyDirection nonHorizontal = (scaledVertAbs > horizAbs * upperSlope ? CANNY_DIRECTION_VERTICAL : diagonal);
+
+  return (scaledVertAbs <= horizAbs * lowerSlope ? CANNY_DIRECTION_HORIZONTAL : nonHorizontal);
+}
+
+inline CannyDirection quantizeDirection(float horizGrad, float vertGrad) {
+  const float horizAbs = std::abs(horizGrad);
+  const float vertAbs = std::abs(vertGrad);
+
+  const CannyDirection diagonal = ((horizGrad < 0) == (vertGrad < 0) ? CANNY_DIRECTION_DIAGONAL : CANNY_DIRECTION_ANTIDIAGONAL);
+  const CannyDirection nonHorizontal = (vertAbs > horizAbs * 2.41421356f ? CANNY_DIRECTION_VERTICAL : diagonal);
+
+  return (vertAbs <= horizAbs * 0.41421356f ? CANNY_DIRECTION_HORIZONTAL : nonHorizontal);
+}
+
+// The binomial blur's sums are weighted by 256 in all, integer ones being rounded to the nearest
+template <typename T> T normalizeBlurredSum(int32_t sum) { return Simd::saturateCast<T>((sum + 128) >> 8); }
+template <typename T> T normalizeBlurredSum(float sum) { return static_cast<T>(sum * (1.f / 256)); }
+
+// Blurs a gray matrix by the 5x5 binomial kernel, computes its Sobel gradients & suppresses the magnitudes that are not
+//  maxima along their gradient's direction, in a single pass: each thread sweeps a band of rows, keeping the last 5
+//  horizontally blurred rows, the last 3 blurred rows & the last 3 magnitude rows in rolling buffers small enough to
+//  stay in cache. Edges are replicated, & magnitudes out of the matrix count as 0
+template <typename T, typename TG>
+void suppressNonMaxima(const Matrix<T>& grayMat, Matrix<TG>& suppressedMat) {
+  using SumType = ConvolutionSum<T>;
+
+  const std::size_t width = grayMat.getWidth();
+  const std::size_t height = grayMat.getHeight();
+
+  suppressedMat.reshape(width, height, 1, grayMat.getImgBitDepth(), ARCV_COLORSPACE_GRAY, suppressedMat.hasPaddedRows());
+
+  if (width == 0 || height == 0)
+    return;
+
+  const auto clampRow = [height] (std::ptrdiff_t heightIndex) {
+    return static_cast<std::size_t>(std::min(std::max(heightIndex, std::ptrdiff_t(0)), static_cast<std::ptrdiff_t>(height) - 1));
+  };
+
+  static constexpr SumType blurWeights[] = { 1, 4, 6, 4, 1 };
+  static constexpr std::ptrdiff_t horizBlurOffsets[] = { 0, 1, 2, 3, 4 };
+
+  // Rows are split into as many bands as threads, each one having its own buffers; those are drawn beforehand from the
+  //  current memory arena, if any, arenas being only usable from the calling thread. Blurred & magnitude rows are given
+  //  a replicated & a zero element on each side, respectively
+  const std::size_t bandCount = std::min(height, ThreadPool::getInstance().getThreadCount());
+  MemoryArena* arena = MemoryArena::getCurrent();
+
+  std::vector<T, AlignedAllocator<T>> paddedGrayRowBuffers(bandCount * (width + 4), T(0), AlignedAllocator<T>(arena));
+  std::vector<SumType, AlignedAllocator<SumType>> horizBlurredRowBuffers(bandCount * 5 * width, SumType(0),
+                                                                         AlignedAllocator<SumType>(arena));
+  std::vector<SumType, AlignedAllocator<SumType>> blurredSumBuffers(bandCount * width, SumType(0), AlignedAllocator<SumType>(arena));
+  std::vector<T, AlignedAllocator<T>> blurredRowBuffers(bandCount * 3 * (width + 2), T(0), AlignedAllocator<T>(arena));
+  std::vector<TG, AlignedAllocator<TG>> magnitudeRowBuffers(bandCount * 3 * (width + 2), TG(0), AlignedAllocator<TG>(arena));
+  std::vector<uint8_t, AlignedAllocator<uint8_t>> directionRowBuffers(bandCount * 3 * width, 0, AlignedAllocator<uint8_t>(arena));
+
+  ThreadPool::getInstance().parallelFor(bandCount, [&] (std::size_t bandBegin, std::size_t bandEnd) {
+    for (std::size_t bandIndex = bandBegin; bandIndex < bandEnd; ++bandIndex) {
+      const std::size_t begin = bandIndex * height / bandCount;
+      const std::size_t end = (bandIndex + 1) * height / bandCount;
+
+      T* paddedGrayRow = paddedGrayRowBuffers.data() + bandIndex * (width + 4);
+      SumType* horizBlurredRows = horizBlurredRowBuffers.data() + bandIndex * 5 * width;
+      SumType* blurredSums = blurredSumBuffers.data() + bandIndex * width;
+      T* blurredRows = blurredRowBuffers.data() + bandIndex * 3 * (width + 2);
+      TG* magnitudeRows = magnitudeRowBuffers.data() + bandIndex * 3 * (width + 2);
+      uint8_t* directionRows = directionRowBuffers.data() + bandIndex * 3 * width;
+
+      // Rows are computed on demand in increasing order, each buffer's slot being the row index modulo its row count;
+      //  the first ones needed are those around the magnitude row above the band
+      std::size_t nextHorizBlurredRow = clampRow(static_cast<std::ptrdiff_t>(begin) - 4);
+      std::size_t nextBlurredRow = clampRow(static_cast<std::ptrdiff_t>(begin) - 2);
+
+      const auto computeHorizBlurredRow = [&] (std::size_t heightIndex) {
+        const T* grayRow = grayMat.getData().data() + heightIndex * grayMat.getStride();
+
+        std::copy(grayRow, grayRow + width, paddedGrayRow + 2);
+        std::fill_n(paddedGrayRow, 2, grayRow[0]);
+        std::fill_n(paddedGrayRow + width + 2, 2, grayRow[width - 1]);
+
+        Simd::computeWeightedSums(paddedGrayRow, horizBlurredRows + (heightIndex % 5) * width, width,
+                                  horizBlurOffsets, blurWeights, 5);
+      };
+
+      const auto computeBlurredRow = [&] (std::size_t heightIndex) {
+        for (; nextHorizBlurredRow <= clampRow(static_cast<std::ptrdiff_t>(heightIndex) + 2); ++nextHorizBlurredRow)
+          computeHorizBlurredRow(nextHorizBlurredRow);
+
+        std::ptrdiff_t vertBlurOffsets[5];
+        for (std::ptrdiff_t rowOffset = -2; rowOffset <= 2; ++rowOffset)
+          vertBlurOffsets[rowOffset + 2] = (clampRow(static_cast<std::ptrdiff_t>(heightIndex) + rowOffset) % 5) * width;
+
+        Simd::computeWeightedSums(horizBlurredRows, blurredSums, width, vertBlurOffsets, blurWeights, 5);
+
+        T* blurredRow = blurredRows + (heightIndex % 3) * (width + 2);
+        for (std::size_t widthIndex = 0; widthIndex < width; ++widthIndex)
+          blurredRow[widthIndex + 1] = normalizeBlurredSum<T>(blurredSums[widthIndex]);
+        blurredRow[0] = blurredRow[1];
+        blurredRow[width + 1] = blurredRow[width];
+      };
+
+      // Sobel gradients are split into a vertical smoothing & difference, then a horizontal difference & smoothing; as
+      //  those of the whole matrices, they are saturated to the gradient type, & their magnitudes as well
+      const auto computeMagnitudeRow = [&] (std::ptrdiff_t heightIndex) {
+        const std::size_t slot = static_cast<std::size_t>(heightIndex + 1) % 3;
+        TG* magnitudeRow = magnitudeRows + slot * (width + 2);
+        uint8_t* directionRow = directionRows + slot * width;
+
+        if (heightIndex < 0 || heightIndex >= static_cast<std::ptrdiff_t>(height)) {
+          std::fill_n(magnitudeRow, width + 2, TG(0));
+          return;
+        }
+
+        for (; nextBlurredRow <= clampRow(heightIndex + 1); ++nextBlurredRow)
+          computeBlurredRow(nextBlurredRow);
+
+        // Rows point to their left padding element, the widthIndex-th one being then on their (widthIndex + 1)-th position
+        const T* upperRow = blurredRows + (clampRow(heightIndex - 1) % 3) * (width + 2);
+        const T* row = blurredRows + (static_cast<std::size_t>(heightIndex) % 3) * (width + 2);
+        const T* lowerRow = blurredRows + (clampRow(heightIndex + 1) % 3) * (width + 2);
+
+        magnitudeRow[0] = 0;
+        magnitudeRow[width + 1] = 0;
+
+        for (std::size_t widthIndex = 0; widthIndex < width; ++widthIndex) {
+          const SumType smoothedLeft = static_cast<SumType>(upperRow[widthIndex]) + 2 * row[widthIndex] + lowerRow[widthIndex];
+          const SumType smoothedRight = static_cast<SumType>(upperRow[widthIndex + 2]) + 2 * row[widthIndex + 2] + lowerRow[widthIndex + 2];
+          const SumType diffLeft = static_cast<SumType>(upperRow[widthIndex]) - lowerRow[widthIndex];
+          const SumType diff = static_cast<SumType>(upperRow[widthIndex + 1]) - lowerRow[widthIndex + 1];
+          const SumType diffRight = static_cast<SumType>(upperRow[widthIndex + 2]) - lowerRow[widthIndex + 2];
+
+          const TG horizGrad = Simd::saturateCast<TG>(smoothedLeft - smoothedRight);
+          const TG vertGrad = Simd::saturateCast<TG>(diffLeft + 2 * diff + diffRight);
+          const float horizVal = horizGrad;
+          const float vertVal = vertGrad;
+
+          magnitudeRow[widthIndex + 1] = Simd::saturateCast<TG>(std::sqrt(horizVal * horizVal + vertVal * vertVal));
+          directionRow[widthIndex] = quantizeDirection(horizGrad, vertGrad);
+        }
+      };
+
+      computeMagnitudeRow(static_cast<std::ptrdiff_t>(begin) - 1);
+      computeMagnitudeRow(static_cast<std::ptrdiff_t>(begin));
+
+      for (std::size_t heightIndex = begin; heightIndex < end; ++heightIndex) {
+        computeMagnitudeRow(static_cast<std::ptrdiff_t>(heightIndex) + 1);
+
+        const std::size_t slot = (heightIndex + 1) % 3;
+        const TG* row = magnitudeRows + slot * (width + 2) + 1;
+        const std::ptrdiff_t upperOffset = static_cast<std::ptrdiff_t>((heightIndex % 3) * (width + 2)) - static_cast<std::ptrdiff_t>(slot * (width + 2));
+        const std::ptrdiff_t lowerOffset = static_cast<std::ptrdiff_t>(((heightIndex + 2) % 3) * (width + 2)) - static_cast<std::ptrdiff_t>(slot * (width + 2));
+        const uint8_t* directionRow = directionRows + slot * width;
+        TG* suppressedRow = suppressedMat.getData().data() + heightIndex * suppressedMat.getStride();
+
+        // Both neighbours compared along each direction, as offsets from the element; they are looked up rather than
+        //  branched to, directions being hardly predictable
+        const std::ptrdiff_t neighbourOffsets[4][2] = { { -1, 1 },
+                                                        { upperOffset - 1, lowerOffset + 1 },
+                                                        { upperOffset, lowerOffset },
+                                                        { upperOffset + 1, lowerOffset - 1 } };
+
+        for (std::size_t widthIndex = 0; widthIndex < width; ++widthIndex) {
+          const TG* element = row + widthIndex;
+          const std::ptrdiff_t* offsets = neighbourOffsets[directionRow[widthIndex]];
+          const TG magnitude = *element;
+
+          suppressedRow[widthIndex] = (std::max(element[offsets[0]], element[offsets[1]]) > magnitude ? TG(0) : magnitude);
+        }
       }
     }
-  }
+  });
+}
+
+template <typename T>
+void detect(const Matrix<T>& mat, Matrix<T>& res, DetectorTag<ARCV_DETECTOR_TYPE_CANNY>) {
+  using GradientType = typename Sobel<T>::GradientType;
 
-  return threshold<ARCV_THRESH_TYPE_HYSTERESIS_AUTO>(res);
+  // Temporaries are drawn from the current memory arena, if any; a single-channel input is already gray
+  Matrix<T> convertedMat(AlignedAllocator<T>(MemoryArena::getCurrent()));
+  if (mat.getChannelCount() != 1)
+    changeColorspace<ARCV_COLORSPACE_GRAY>(mat, convertedMat);
+  const Matrix<T>& grayMat = (mat.getChannelCount() != 1 ? convertedMat : mat);
+
+  Matrix<GradientType> suppressedMat(AlignedAllocator<GradientType>(MemoryArena::getCurrent()));
+  suppressNonMaxima(grayMat, suppressedMat);
+
+  thresholdEdges(suppressedMat, res);
 }
 
-template <>
-Matrix<> applyDetector<ARCV_DETECTOR_TYPE_HARRIS>(const Matrix<>& mat) {
-  Matrix<> res = changeColorspace<ARCV_COLORSPACE_GRAY>(mat);
+template <typename T>
+void detect(const Matrix<T>& mat, Matrix<T>& res, DetectorTag<ARCV_DETECTOR_TYPE_HARRIS>) {
+  using GradientType = typename Sobel<T>::GradientType;
+
+  const AlignedAllocator<GradientType> scratchAllocator(MemoryArena::getCurrent());
+
+  Matrix<GradientType> horizRes(scratchAllocator);
+  Matrix<GradientType> vertRes(scratchAllocator);
+  Sobel<T>::computeHorizontalSobelOperator(mat, horizRes);
+  Sobel<T>::computeVerticalSobelOperator(mat, vertRes);
 
-  Matrix<float> horizRes = Sobel::computeHorizontalSobelOperator(mat);
-  Matrix<float> vertRes = Sobel::computeVerticalSobelOperator(mat);
+  // The input is not needed anymore, allowing the conversion to be done in place
+  changeColorspace<ARCV_COLORSPACE_GRAY>(mat, res);
 
-  Matrix<float> mult = horizRes * vertRes;
-  horizRes *= horizRes;
-  vertRes *= vertRes;
+  // Lazily evaluated, each response being computed only when compared; integer gradients are promoted to floats,
+  //  their products overflowing otherwise
+  const auto horizFloat = 1.f * horizRes;
+  const auto vertFloat = 1.f * vertRes;
+  const auto horizSquared = horizFloat * horizFloat;
+  const auto vertSquared = vertFloat * vertFloat;
+  const auto mult = horizFloat * vertFloat;
+  const auto response = (horizSquared * vertSquared - mult * mult) - 0.04f * (horizSquared + vertSquared) * (horizSquared + vertSquared);
 
   for (std::size_t i = 0; i < res.getData().size(); ++i) {
-    if ((horizRes.getData()[i] * vertRes.getData()[i] - mult.getData()[i] * mult.getData()[i])
-        - 0.04f * std::pow(horizRes.getData()[i] + vertRes.getData()[i], 2.f) > 255)
+    if (response[i] > 255)
       res.getData()[i] = 255;
   }
+}
+
+} // namespace
 
-  return res;
+template <DetectorType D, typename T>
+void applyDetector(const Matrix<T>& mat, Matrix<T>& res) {
+  detect(mat, res, DetectorTag<D>());
 }
 
+template void applyDetector<ARCV_DETECTOR_TYPE_CANNY>(const Matrix<float>& mat, Matrix<float>& res);
+template void applyDetector<ARCV_DETECTOR_TYPE_CANNY>(const Matrix<uint8_t>& mat, Matrix<uint8_t>& res);
+template void applyDetector<ARCV_DETECTOR_TYPE_CANNY>(const Matrix<int16_t>& mat, Matrix<int16_t>& res);
+template void applyDetector<ARCV_DETECTOR_TYPE_HARRIS>(const Matrix<float>& mat, Matrix<float>& res);
+template void applyDetector<ARCV_DETECTOR_TYPE_HARRIS>(const Matrix<uint8_t>& mat, Matrix<uint8_t>& res);
+template void applyDetector<ARCV_DETECTOR_TYPE_HARRIS>(const Matrix<int16_t>& mat, Matrix<int16_t>& res);
+
 } // namespace Image
 
 } // namespace Arcv
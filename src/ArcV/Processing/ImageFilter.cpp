@@ -1,47 +1,912 @@
+#include <array>
+#include <cmath>
+#include <algorithm>
+
+#include "ArcV/Math/StaticKernel.hpp"
+#include "ArcV/Math/IntegralImage.hpp"
 #include "ArcV/Processing/Image.hpp"
 
 namespace Arcv {
 
 namespace Image {
 
-template <>
-Matrix<> applyFilter<ARCV_FILTER_TYPE_GAUSSIAN_BLUR>(Matrix<> mat) {
-  Matrix<float> kernel = {{ 1.f,  4.f,  6.f,  4.f, 1.f },
-                          { 4.f, 16.f, 24.f, 16.f, 4.f },
-                          { 6.f, 24.f, 36.f, 24.f, 6.f },
-                          { 4.f, 16.f, 24.f, 16.f, 4.f },
-                          { 1.f,  4.f,  6.f,  4.f, 1.f }};
+namespace {
+
+template <FilterType F> using FilterTag = std::integral_constant<FilterType, F>;
+
+template <typename T>
+void filter(const MatrixView<const T>& mat, Matrix<T>& res, FilterTag<ARCV_FILTER_TYPE_GAUSSIAN_BLUR>) {
+  // The 5x5 binomial kernel being the outer product of { 1, 4, 6, 4, 1 } / 16 with itself
+  static const Matrix<float> rowKernel = Matrix<float>({{ 1.f, 4.f, 6.f, 4.f, 1.f }}) / 16;
+  static const Matrix<float> columnKernel = Matrix<float>({{ 1.f }, { 4.f }, { 6.f }, { 4.f }, { 1.f }}) / 16;
+
+  convolveSeparable(mat, rowKernel, columnKernel, res);
+}
+
+template <typename T>
+void filter(const MatrixView<const T>& mat, Matrix<T>& res, FilterTag<ARCV_FILTER_TYPE_SHARPEN>) {
+  using Kernel = StaticKernel<0,  0, -1,  0,
+                                 -1,  5, -1,
+                                  0, -1,  0>;
+
+  convolve(mat, Kernel(), res);
+}
+
+template <typename T>
+void filter(const MatrixView<const T>& mat, Matrix<T>& res, FilterTag<ARCV_FILTER_TYPE_EDGE_ENHANCEMENT>) {
+  using Kernel = StaticKernel<0, 0,  1, 0,
+                                 1, -4, 1,
+                                 0,  1, 0>;
+
+  convolve(mat, Kernel(), res);
+}
+
+template <typename T>
+void filter(const MatrixView<const T>& mat, Matrix<T>& res, FilterTag<ARCV_FILTER_TYPE_EMBOSS>) {
+  using Kernel = StaticKernel<0, -2, -1, 0,
+                                 -1,  1, 1,
+                                  0,  1, 2>;
+
+  convolve(mat, Kernel(), res);
+}
+
+// Young & van Vliet's third order recursive approximation of a Gaussian, whose coefficients { B, b1 / b0, b2 / b0, b3 / b0 }
+//  give each value as B times the input plus the weighted previous outputs; a forward then a backward pass make it
+//  symmetric. The edge matrix is Triggs & Sdika's, giving the backward pass' first values when edges are replicated
+struct RecursiveGaussian {
+  explicit RecursiveGaussian(float sigma) {
+    const double q = (sigma >= 2.5f ? 0.98711 * sigma - 0.96330 : 3.97156 - 4.14554 * std::sqrt(1.0 - 0.26891 * sigma));
+    const double b0 = 1.57825 + 2.44413 * q + 1.4281 * q * q + 0.422205 * q * q * q;
+    const double a1 = (2.44413 * q + 2.85619 * q * q + 1.26661 * q * q * q) / b0;
+    const double a2 = -(1.4281 * q * q + 1.26661 * q * q * q) / b0;
+    const double a3 = 0.422205 * q * q * q / b0;
+    const double inputFactor = 1.0 - (a1 + a2 + a3);
+
+    coefficients = { static_cast<float>(inputFactor), static_cast<float>(a1), static_cast<float>(a2), static_cast<float>(a3) };
+
+    // Forward outputs being scaled by B, so is the matrix
+    const double scale = inputFactor / ((1.0 + a1 - a2 + a3) * (1.0 - a1 - a2 - a3) * (1.0 + a2 + (a1 - a3) * a3));
+    const double edgeMatrixValues[3][3] = {
+      { -a3 * a1 + 1.0 - a3 * a3 - a2, (a3 + a1) * (a2 + a3 * a1), a3 * (a1 + a3 * a2) },
+      { a1 + a3 * a2, -(a2 - 1.0) * (a2 + a3 * a1), -a3 * (a3 * a1 + a3 * a3 + a2 - 1.0) },
+      { a3 * a1 + a2 + a1 * a1 - a2 * a2, a1 * a2 + a3 * a2 * a2 - a1 * a3 * a3 - a3 * a3 * a3 - a3 * a2 + a3, a3 * (a1 + a3 * a2) }
+    };
+
+    for (std::size_t rowIndex = 0; rowIndex < 3; ++rowIndex) {
+      for (std::size_t columnIndex = 0; columnIndex < 3; ++columnIndex)
+        edgeMatrix[rowIndex][columnIndex] = static_cast<float>(edgeMatrixValues[rowIndex][columnIndex] * scale);
+    }
+  }
+
+  std::array<float, 4> coefficients;
+  std::array<std::array<float, 3>, 3> edgeMatrix;
+};
+
+// Filters laneCount independent lanes along count rows, rowStride values apart, in place; edgeRows holds 3 rows of laneCount
+//  values. Coefficients summing to 1, the forward pass gives back the first row unchanged, which thus stands for the
+//  replicated ones before it; the backward pass starts from the values that rows replicated after the last one would give
+void applyRecursiveGaussian(float* data, std::size_t count, std::size_t rowStride, std::size_t laneCount,
+                            const RecursiveGaussian& gaussian, float* edgeRows) {
+  const std::ptrdiff_t rowCount = static_cast<std::ptrdiff_t>(count);
+  float* lastInputs = edgeRows;
+  float* nextRows[] = { edgeRows + laneCount, edgeRows + 2 * laneCount };
+  const auto getRow = [data, rowStride, rowCount, &nextRows] (std::ptrdiff_t rowIndex) {
+    return (rowIndex >= rowCount ? nextRows[rowIndex - rowCount] : data + std::max<std::ptrdiff_t>(rowIndex, 0) * rowStride);
+  };
+
+  std::copy_n(getRow(rowCount - 1), laneCount, lastInputs);
+
+  for (std::ptrdiff_t rowIndex = 1; rowIndex < rowCount; ++rowIndex) {
+    const float* previousRows[] = { getRow(rowIndex - 1), getRow(rowIndex - 2), getRow(rowIndex - 3) };
+    Simd::computeRecursiveFilterRow(getRow(rowIndex), previousRows, getRow(rowIndex), laneCount, gaussian.coefficients.data());
+  }
+
+  float* lastRows[] = { getRow(rowCount - 1), getRow(rowCount - 2), getRow(rowCount - 3) };
+
+  for (std::size_t laneIndex = 0; laneIndex < laneCount; ++laneIndex) {
+    const float edgeValue = lastInputs[laneIndex];
+    const float differences[] = { lastRows[0][laneIndex] - edgeValue, lastRows[1][laneIndex] - edgeValue, lastRows[2][laneIndex] - edgeValue };
+    float edgeOutputs[3];
+
+    for (std::size_t rowIndex = 0; rowIndex < 3; ++rowIndex) {
+      const std::array<float, 3>& factors = gaussian.edgeMatrix[rowIndex];
+      edgeOutputs[rowIndex] = factors[0] * differences[0] + factors[1] * differences[1] + factors[2] * differences[2] + edgeValue;
+    }
+
+    lastRows[0][laneIndex] = edgeOutputs[0];
+    nextRows[0][laneIndex] = edgeOutputs[1];
+    nextRows[1][laneIndex] = edgeOutputs[2];
+  }
+
+  for (std::ptrdiff_t rowIndex = rowCount - 2; rowIndex >= 0; --rowIndex) {
+    const float* previousRows[] = { getRow(rowIndex + 1), getRow(rowIndex + 2), getRow(rowIndex + 3) };
+    Simd::computeRecursiveFilterRow(getRow(rowIndex), previousRows, getRow(rowIndex), laneCount, gaussian.coefficients.data());
+  }
+}
+
+// Below this sigma, recursive filters stray too far from a Gaussian, which is then sampled into a kernel spanning 3 sigmas
+//  on each side, of at most 13 weights
+constexpr float RecursiveGaussianMinSigma = 2.f;
+
+// Normalized row or column kernel of a sampled Gaussian, a single weight of 1 for a sigma of 0
+Matrix<float> computeGaussianKernel(float sigma, bool isColumn) {
+  const std::ptrdiff_t radius = static_cast<std::ptrdiff_t>(std::ceil(3.f * sigma));
+  const std::size_t size = static_cast<std::size_t>(2 * radius + 1);
+  Matrix<float> kernel(isColumn ? 1 : size, isColumn ? size : 1);
+
+  float weightSum = 0.f;
+  for (std::ptrdiff_t offset = -radius; offset <= radius; ++offset) {
+    kernel[offset + radius] = (offset == 0 ? 1.f : std::exp(-static_cast<float>(offset * offset) / (2.f * sigma * sigma)));
+    weightSum += kernel[offset + radius];
+  }
+
+  for (std::size_t weightIndex = 0; weightIndex < size; ++weightIndex)
+    kernel[weightIndex] /= weightSum;
+
+  return kernel;
+}
+
+// Integer results are rounded to the nearest, as convolutions' fixed point ones are
+template <typename T>
+T convertBlurredValue(float value) {
+  return Simd::saturateCast<T>(std::is_integral<T>::value ? std::floor(value + 0.5f) : value);
+}
+
+// Medians of the neighbourhoods lying across rows of the matrix extended by replicated edges, kernelSize of which are
+//  kept in a ring buffer; 3x3 & 5x5 ones go through vectorized median networks, larger ones being partially sorted
+template <typename T>
+void computeWindowMedians(const MatrixView<const T>& mat, const MatrixView<T>& res, std::size_t kernelSize) {
+  const std::ptrdiff_t radius = static_cast<std::ptrdiff_t>(kernelSize - 1) / 2;
+  const std::size_t channelCount = mat.getChannelCount();
+  const std::size_t rowLength = mat.getRowLength();
+  const std::size_t borderedRowLength = rowLength + 2 * radius * channelCount;
+  const std::size_t windowSize = kernelSize * kernelSize;
+  const bool hasNetwork = (kernelSize == 3 || kernelSize == 5);
+
+  ThreadPool::getInstance().parallelFor(mat.getHeight(), [&] (std::size_t begin, std::size_t end) {
+    std::vector<T> borderedRows(kernelSize * borderedRowLength);
+    std::vector<const T*> inputs(windowSize);
+    std::vector<T> values(hasNetwork ? 0 : windowSize);
+
+    const auto getBorderedRow = [&] (std::ptrdiff_t rowIndex) {
+      return borderedRows.data() + static_cast<std::size_t>(rowIndex + radius) % kernelSize * borderedRowLength;
+    };
+
+    const auto fillBorderedRow = [&] (std::ptrdiff_t rowIndex) {
+      const T* row = mat.getRow(static_cast<std::size_t>(std::min(std::max<std::ptrdiff_t>(rowIndex, 0),
+                                                                  static_cast<std::ptrdiff_t>(mat.getHeight()) - 1)));
+      T* borderedRow = getBorderedRow(rowIndex);
+
+      std::copy(row, row + rowLength, borderedRow + radius * channelCount);
+
+      for (std::ptrdiff_t columnIndex = 0; columnIndex < radius; ++columnIndex) {
+        std::copy(row, row + channelCount, borderedRow + columnIndex * channelCount);
+        std::copy(row + rowLength - channelCount, row + rowLength, borderedRow + borderedRowLength - (columnIndex + 1) * channelCount);
+      }
+    };
+
+    for (std::ptrdiff_t rowIndex = static_cast<std::ptrdiff_t>(begin) - radius; rowIndex < static_cast<std::ptrdiff_t>(begin) + radius; ++rowIndex)
+      fillBorderedRow(rowIndex);
+
+    for (std::size_t rowIndex = begin; rowIndex < end; ++rowIndex) {
+      fillBorderedRow(static_cast<std::ptrdiff_t>(rowIndex) + radius);
+
+      for (std::size_t kernelRowIndex = 0; kernelRowIndex < kernelSize; ++kernelRowIndex) {
+        const T* borderedRow = getBorderedRow(static_cast<std::ptrdiff_t>(rowIndex + kernelRowIndex) - radius);
+
+        for (std::size_t kernelColumnIndex = 0; kernelColumnIndex < kernelSize; ++kernelColumnIndex)
+          inputs[kernelRowIndex * kernelSize + kernelColumnIndex] = borderedRow + kernelColumnIndex * channelCount;
+      }
+
+      T* resRow = res.getRow(rowIndex);
+
+      if (hasNetwork) {
+        Simd::computeMedians(inputs.data(), resRow, rowLength, windowSize);
+        continue;
+      }
+
+      for (std::size_t eltIndex = 0; eltIndex < rowLength; ++eltIndex) {
+        for (std::size_t valueIndex = 0; valueIndex < windowSize; ++valueIndex)
+          values[valueIndex] = inputs[valueIndex][eltIndex];
+
+        std::nth_element(values.begin(), values.begin() + windowSize / 2, values.end());
+        resRow[eltIndex] = values[windowSize / 2];
+      }
+    }
+  });
+}
+
+template <typename T>
+void computeLargeMedians(const MatrixView<const T>& mat, const MatrixView<T>& res, std::size_t kernelSize) {
+  computeWindowMedians(mat, res, kernelSize);
+}
+
+// Perreault & Hébert's constant time median: each column keeps the histogram of its kernelSize elements, updated by an
+//  element in & one out from a row to the next, & the kernel's histogram is updated by a column in & one out from an
+//  element to the next. Histograms have 16 coarse bins of 16 fine ones; only the coarse ones of the kernel's histogram
+//  are kept up to date, the fine ones of a coarse bin being brought to the current element when the median lies in it
+// Rows are swept by strips of columns, so that the histograms of a strip's columns stay in cache
+void computeLargeMedians(const MatrixView<const uint8_t>& mat, const MatrixView<uint8_t>& res, std::size_t kernelSize) {
+  // Counts of up to kernelSize^2 elements being stored on 16 bits
+  assert(("Error: Median filter kernel's size must be less than 256", kernelSize < 256));
+
+  constexpr std::size_t BinCount = 16;
+  constexpr std::ptrdiff_t StripWidth = 256;
+
+  const std::ptrdiff_t radius = static_cast<std::ptrdiff_t>(kernelSize - 1) / 2;
+  const std::ptrdiff_t width = static_cast<std::ptrdiff_t>(mat.getWidth());
+  const std::ptrdiff_t height = static_cast<std::ptrdiff_t>(mat.getHeight());
+  const std::size_t channelCount = mat.getChannelCount();
+  const std::size_t medianRank = kernelSize * kernelSize / 2;
+  const std::size_t maxColumnCount = static_cast<std::size_t>(std::min(width, StripWidth + 2 * radius));
+
+  const auto addColumn = [] (uint16_t* histogram, const uint16_t* columnHistogram) {
+    for (std::size_t binIndex = 0; binIndex < BinCount; ++binIndex)
+      histogram[binIndex] += columnHistogram[binIndex];
+  };
+
+  // Counts wrapping around on 16 bits, a column can be added & another one subtracted in a single pass
+  const auto replaceColumn = [] (uint16_t* histogram, const uint16_t* addedHistogram, const uint16_t* removedHistogram) {
+    for (std::size_t binIndex = 0; binIndex < BinCount; ++binIndex)
+      histogram[binIndex] += static_cast<uint16_t>(addedHistogram[binIndex] - removedHistogram[binIndex]);
+  };
+
+  ThreadPool::getInstance().parallelFor(mat.getHeight(), [&] (std::size_t begin, std::size_t end) {
+    std::vector<uint16_t> columnCoarseHistograms(maxColumnCount * channelCount * BinCount);
+    std::vector<uint16_t> columnFineHistograms(maxColumnCount * channelCount * BinCount * BinCount);
+
+    for (std::ptrdiff_t stripBegin = 0; stripBegin < width; stripBegin += StripWidth) {
+      const std::ptrdiff_t stripEnd = std::min(stripBegin + StripWidth, width);
+      const std::ptrdiff_t columnBegin = std::max<std::ptrdiff_t>(stripBegin - radius, 0);
+      const std::ptrdiff_t columnEnd = std::min(stripEnd + radius, width);
+      const std::size_t stripRowLength = static_cast<std::size_t>(columnEnd - columnBegin) * channelCount;
+
+      std::fill(columnCoarseHistograms.begin(), columnCoarseHistograms.end(), 0);
+      std::fill(columnFineHistograms.begin(), columnFineHistograms.end(), 0);
+
+      const auto updateColumns = [&] (std::ptrdiff_t rowIndex, uint16_t increment) {
+        const uint8_t* row = mat.getRow(static_cast<std::size_t>(std::min(std::max<std::ptrdiff_t>(rowIndex, 0), height - 1)))
+                           + static_cast<std::size_t>(columnBegin) * channelCount;
+
+        for (std::size_t eltIndex = 0; eltIndex < stripRowLength; ++eltIndex) {
+          columnCoarseHistograms[eltIndex * BinCount + row[eltIndex] / BinCount] += increment;
+          columnFineHistograms[eltIndex * BinCount * BinCount + row[eltIndex]] += increment;
+        }
+      };
+
+      for (std::ptrdiff_t rowIndex = static_cast<std::ptrdiff_t>(begin) - radius; rowIndex <= static_cast<std::ptrdiff_t>(begin) + radius; ++rowIndex)
+        updateColumns(rowIndex, 1);
+
+      for (std::size_t rowIndex = begin; rowIndex < end; ++rowIndex) {
+        // Subtracting is done by adding the 16-bit complement
+        if (rowIndex > begin) {
+          updateColumns(static_cast<std::ptrdiff_t>(rowIndex) - radius - 1, static_cast<uint16_t>(-1));
+          updateColumns(static_cast<std::ptrdiff_t>(rowIndex) + radius, 1);
+        }
+
+        uint8_t* resRow = res.getRow(rowIndex);
+
+        for (std::size_t chan = 0; chan < channelCount; ++chan) {
+          const auto getColumnIndex = [&] (std::ptrdiff_t columnIndex) {
+            return static_cast<std::size_t>(std::min(std::max(columnIndex, std::ptrdiff_t(0)), width - 1) - columnBegin) * channelCount + chan;
+          };
+
+          uint16_t coarseHistogram[BinCount] {};
+          uint16_t fineHistograms[BinCount][BinCount];
+          // Columns up to which each coarse bin's fine histogram is brought, set so that they are first filled entirely
+          std::ptrdiff_t finePositions[BinCount];
+          std::fill_n(finePositions, BinCount, stripBegin - static_cast<std::ptrdiff_t>(kernelSize) - 1);
+
+          for (std::ptrdiff_t columnIndex = stripBegin - radius; columnIndex <= stripBegin + radius; ++columnIndex)
+            addColumn(coarseHistogram, columnCoarseHistograms.data() + getColumnIndex(columnIndex) * BinCount);
+
+          for (std::ptrdiff_t columnIndex = stripBegin; columnIndex < stripEnd; ++columnIndex) {
+            if (columnIndex > stripBegin) {
+              replaceColumn(coarseHistogram, columnCoarseHistograms.data() + getColumnIndex(columnIndex + radius) * BinCount,
+                            columnCoarseHistograms.data() + getColumnIndex(columnIndex - radius - 1) * BinCount);
+            }
+
+            std::size_t count = 0;
+            std::size_t coarseBin = 0;
+
+            while (count + coarseHistogram[coarseBin] <= medianRank)
+              count += coarseHistogram[coarseBin++];
+
+            uint16_t* fineHistogram = fineHistograms[coarseBin];
+            const auto getFineColumn = [&] (std::ptrdiff_t fineColumnIndex) {
+              return columnFineHistograms.data() + getColumnIndex(fineColumnIndex) * BinCount * BinCount + coarseBin * BinCount;
+            };
+
+            // The fine histogram is moved column by column, unless it was left so far behind that summing its columns is cheaper
+            if (2 * (columnIndex - finePositions[coarseBin]) > static_cast<std::ptrdiff_t>(kernelSize)) {
+              std::fill_n(fineHistogram, BinCount, 0);
+
+              for (std::ptrdiff_t fineColumnIndex = columnIndex - radius; fineColumnIndex <= columnIndex + radius; ++fineColumnIndex)
+                addColumn(fineHistogram, getFineColumn(fineColumnIndex));
+            } else {
+              for (std::ptrdiff_t fineColumnIndex = finePositions[coarseBin] + 1; fineColumnIndex <= columnIndex; ++fineColumnIndex)
+                replaceColumn(fineHistogram, getFineColumn(fineColumnIndex + radius), getFineColumn(fineColumnIndex - radius - 1));
+            }
+
+            finePositions[coarseBin] = columnIndex;
+
+            std::size_t fineBin = 0;
+            while (count + fineHistogram[fineBin] <= medianRank)
+              count += fineHistogram[fineBin++];
+
+            resRow[static_cast<std::size_t>(columnIndex) * channelCount + chan] = static_cast<uint8_t>(coarseBin * BinCount + fineBin);
+          }
+        }
+      }
+    }
+  });
+}
+
+// Bilateral grid's cells span sigmaSpace elements along rows & columns & sigmaRange values; a cell holds the sums of the
+//  values of the elements falling into it followed by their count. Cells are laid out row by row of the grid, each
+//  column of a row holding its cells along the range contiguously; two empty cells pad every axis on both sides
+struct BilateralGrid {
+  static constexpr std::size_t Padding = 2;
+
+  BilateralGrid(std::size_t width, std::size_t height, std::size_t depth, std::size_t channelCount)
+    : width{ width }, height{ height }, depth{ depth }, cellSize{ channelCount + 1 },
+      margin{ 2 * getRowStride() }, values(getRowStride() * height + 2 * margin) {}
+
+  std::size_t getColumnStride() const { return depth * cellSize; }
+  std::size_t getRowStride() const { return width * depth * cellSize; }
+  std::size_t getCellCount() const { return height * getRowStride(); }
+  float* getCells() { return values.data() + margin; }
+  float* getCell(std::size_t widthIndex, std::size_t heightIndex, std::size_t depthIndex) {
+    return getCells() + heightIndex * getRowStride() + widthIndex * getColumnStride() + depthIndex * cellSize;
+  }
+
+  std::size_t width, height, depth;
+  std::size_t cellSize;
+  // Cells beyond the grid's both ends, read as empty by the blur
+  std::size_t margin;
+  std::vector<float> values;
+};
+
+constexpr std::size_t BilateralGrid::Padding;
+
+// Blurs the grid along an axis by the binomial kernel { 1, 4, 6, 4, 1 } / 16, of a cell's standard deviation; the cells
+//  stride apart along the axis being all contiguous, the grid is blurred as a whole. Cells read across the grid's ends
+//  are padding ones, still empty as long as the axis is blurred before those along which they are laid out further apart
+void blurBilateralGrid(BilateralGrid& grid, std::vector<float>& blurredValues, std::size_t stride) {
+  constexpr std::size_t ChunkSize = 4096;
+  static const float weights[] = { 1 / 16.f, 4 / 16.f, 6 / 16.f, 4 / 16.f, 1 / 16.f };
+
+  const std::ptrdiff_t axisStride = static_cast<std::ptrdiff_t>(stride);
+  const std::ptrdiff_t offsets[] = { -2 * axisStride, -axisStride, 0, axisStride, 2 * axisStride };
+  const std::size_t cellCount = grid.getCellCount();
+
+  blurredValues.assign(grid.values.size(), 0.f);
+
+  ThreadPool::getInstance().parallelFor((cellCount + ChunkSize - 1) / ChunkSize, [&] (std::size_t begin, std::size_t end) {
+    const std::size_t valueBegin = begin * ChunkSize;
+    const std::size_t valueEnd = std::min(end * ChunkSize, cellCount);
+
+    Simd::computeWeightedSums(grid.getCells() + valueBegin, blurredValues.data() + grid.margin + valueBegin, valueEnd - valueBegin,
+                              offsets, weights, 5);
+  });
+
+  grid.values.swap(blurredValues);
+}
+
+// Averages blocks of factor x factor elements into float ones, the last row & column of blocks possibly being smaller
+template <typename T>
+void downsample(const MatrixView<const T>& mat, std::size_t factor, Matrix<float>& res) {
+  const std::size_t width = mat.getWidth();
+  const std::size_t height = mat.getHeight();
+  const std::size_t channelCount = mat.getChannelCount();
+
+  res.reshape((width + factor - 1) / factor, (height + factor - 1) / factor, mat.getChannelCount(), mat.getImgBitDepth(),
+              mat.getColorspace(), res.hasPaddedRows());
+  const MatrixView<float> resView = res.getView();
+
+  ThreadPool::getInstance().parallelFor(res.getHeight(), [&] (std::size_t begin, std::size_t end) {
+    if (factor == 1) {
+      for (std::size_t rowIndex = begin; rowIndex < end; ++rowIndex)
+        Simd::convert(mat.getRow(rowIndex), resView.getRow(rowIndex), mat.getRowLength());
+
+      return;
+    }
+
+    for (std::size_t resRowIndex = begin; resRowIndex < end; ++resRowIndex) {
+      const std::size_t rowBegin = resRowIndex * factor;
+      const std::size_t rowEnd = std::min(rowBegin + factor, height);
+      float* resRow = resView.getRow(resRowIndex);
+
+      std::fill_n(resRow, resView.getRowLength(), 0.f);
 
-  return mat.convolve(kernel / 256);
+      for (std::size_t rowIndex = rowBegin; rowIndex < rowEnd; ++rowIndex) {
+        const T* row = mat.getRow(rowIndex);
+
+        for (std::size_t columnIndex = 0; columnIndex < width; ++columnIndex) {
+          for (std::size_t chan = 0; chan < channelCount; ++chan)
+            resRow[columnIndex / factor * channelCount + chan] += row[columnIndex * channelCount + chan];
+        }
+      }
+
+      for (std::size_t resColumnIndex = 0; resColumnIndex < res.getWidth(); ++resColumnIndex) {
+        const std::size_t columnCount = std::min(factor, width - resColumnIndex * factor);
+        const float scale = 1.f / static_cast<float>(columnCount * (rowEnd - rowBegin));
+
+        for (std::size_t chan = 0; chan < channelCount; ++chan)
+          resRow[resColumnIndex * channelCount + chan] *= scale;
+      }
+    }
+  });
 }
 
-template <>
-Matrix<> applyFilter<ARCV_FILTER_TYPE_SHARPEN>(Matrix<> mat) {
-  const Matrix<float> kernel = {{  0.f,  -1.f,  0.f },
-                                { -1.f,   5.f, -1.f },
-                                {  0.f,  -1.f,  0.f }};
+// Bilinear interpolation of a downsampled matrix back to the original elements, whose centers map to (index + 0.5) /
+//  factor - 0.5 in the downsampled one: gives, for every original index, its two downsampled neighbours & the second one's weight
+struct UpsamplingTaps {
+  UpsamplingTaps(std::size_t size, std::size_t downsampledSize, std::size_t factor) : firstIndices(size), secondIndices(size), weights(size) {
+    for (std::size_t index = 0; index < size; ++index) {
+      const float position = std::min(std::max((static_cast<float>(index) + 0.5f) / static_cast<float>(factor) - 0.5f, 0.f),
+                                       static_cast<float>(downsampledSize - 1));
+
+      firstIndices[index] = static_cast<std::size_t>(position);
+      secondIndices[index] = std::min(firstIndices[index] + 1, downsampledSize - 1);
+      weights[index] = position - static_cast<float>(firstIndices[index]);
+    }
+  }
+
+  std::vector<std::size_t> firstIndices;
+  std::vector<std::size_t> secondIndices;
+  std::vector<float> weights;
+};
+
+} // namespace
+
+template <typename T>
+void gaussianBlur(const MatrixView<const T>& mat, Matrix<T>& res, float sigmaX, float sigmaY) {
+  assert(("Error: Gaussian standard deviations must be either 0 or at least 0.5",
+          (sigmaX == 0.f || sigmaX >= 0.5f) && (sigmaY == 0.f || sigmaY >= 0.5f)));
+
+  const std::size_t width = mat.getWidth();
+  const std::size_t height = mat.getHeight();
+  const std::size_t channelCount = mat.getChannelCount();
+  const std::size_t rowLength = mat.getRowLength();
+  const bool isRecursiveX = (sigmaX >= RecursiveGaussianMinSigma);
+  const bool isRecursiveY = (sigmaY >= RecursiveGaussianMinSigma);
+
+  // Directions of small sigmas are convolved by sampled kernels, directly into the result if both are
+  if (!isRecursiveX && !isRecursiveY) {
+    convolveSeparable(mat, computeGaussianKernel(sigmaX, false), computeGaussianKernel(sigmaY, true), res, ARCV_BORDER_TYPE_REPLICATE);
+    return;
+  }
+
+  // Values are otherwise filtered in place in floating point, once convolved in the direction of the small sigma if any
+  std::vector<float> values(rowLength * height);
+
+  if (isRecursiveX && isRecursiveY) {
+    for (std::size_t rowIndex = 0; rowIndex < height; ++rowIndex)
+      std::copy_n(mat.getRow(rowIndex), rowLength, values.data() + rowIndex * rowLength);
+  } else {
+    Matrix<float> convolvedMat(AlignedAllocator<float>(MemoryArena::getCurrent()));
+    convolveSeparable(mat, computeGaussianKernel(isRecursiveX ? 0.f : sigmaX, false), computeGaussianKernel(isRecursiveY ? 0.f : sigmaY, true),
+                      convolvedMat, ARCV_BORDER_TYPE_REPLICATE);
+
+    for (std::size_t rowIndex = 0; rowIndex < height; ++rowIndex)
+      std::copy_n(convolvedMat.getView().getRow(rowIndex), rowLength, values.data() + rowIndex * rowLength);
+  }
+
+  res.reshape(width, height, mat.getChannelCount(), mat.getImgBitDepth(), mat.getColorspace(), res.hasPaddedRows());
+  const MatrixView<T> resView = res.getView();
+
+  // Columns are filtered by strips of adjacent elements, processed together by vectors
+  if (isRecursiveY) {
+    constexpr std::size_t StripWidth = 256;
+    const RecursiveGaussian gaussian(sigmaY);
+
+    ThreadPool::getInstance().parallelFor((rowLength + StripWidth - 1) / StripWidth, [&] (std::size_t stripBegin, std::size_t stripEnd) {
+      std::vector<float> edgeRows(3 * StripWidth);
+
+      for (std::size_t stripIndex = stripBegin; stripIndex < stripEnd; ++stripIndex) {
+        const std::size_t columnBegin = stripIndex * StripWidth;
+        applyRecursiveGaussian(values.data() + columnBegin, height, rowLength, std::min(StripWidth, rowLength - columnBegin), gaussian,
+                               edgeRows.data());
+      }
+    });
+  }
+
+  // Rows are filtered by blocks, transposed so that the block's rows lie along vectors
+  constexpr std::size_t BlockHeight = 16;
+  const std::size_t laneCount = BlockHeight * channelCount;
+  const RecursiveGaussian gaussian(std::max(sigmaX, RecursiveGaussianMinSigma));
+
+  ThreadPool::getInstance().parallelFor((height + BlockHeight - 1) / BlockHeight, [&] (std::size_t blockBegin, std::size_t blockEnd) {
+    std::vector<float> block(width * laneCount);
+    std::vector<float> edgeRows(3 * laneCount);
+
+    for (std::size_t blockIndex = blockBegin; blockIndex < blockEnd; ++blockIndex) {
+      const std::size_t rowBegin = blockIndex * BlockHeight;
+      const std::size_t blockHeight = std::min(BlockHeight, height - rowBegin);
+      const std::size_t blockLaneCount = blockHeight * channelCount;
+
+      if (!isRecursiveX) {
+        for (std::size_t rowIndex = 0; rowIndex < blockHeight; ++rowIndex) {
+          const float* valuesRow = values.data() + (rowBegin + rowIndex) * rowLength;
+          std::transform(valuesRow, valuesRow + rowLength, resView.getRow(rowBegin + rowIndex), convertBlurredValue<T>);
+        }
+
+        continue;
+      }
+
+      for (std::size_t rowIndex = 0; rowIndex < blockHeight; ++rowIndex) {
+        const float* valuesRow = values.data() + (rowBegin + rowIndex) * rowLength;
+
+        for (std::size_t columnIndex = 0; columnIndex < width; ++columnIndex) {
+          for (std::size_t chan = 0; chan < channelCount; ++chan)
+            block[columnIndex * blockLaneCount + rowIndex * channelCount + chan] = valuesRow[columnIndex * channelCount + chan];
+        }
+      }
+
+      applyRecursiveGaussian(block.data(), width, blockLaneCount, blockLaneCount, gaussian, edgeRows.data());
+
+      for (std::size_t rowIndex = 0; rowIndex < blockHeight; ++rowIndex) {
+        T* resRow = resView.getRow(rowBegin + rowIndex);
 
-  return mat.convolve(kernel);
+        for (std::size_t columnIndex = 0; columnIndex < width; ++columnIndex) {
+          const float* blockValues = block.data() + columnIndex * blockLaneCount + rowIndex * channelCount;
+
+          for (std::size_t chan = 0; chan < channelCount; ++chan)
+            resRow[columnIndex * channelCount + chan] = convertBlurredValue<T>(blockValues[chan]);
+        }
+      }
+    }
+  });
+}
+
+template <FilterType F, typename T>
+void applyFilter(const MatrixView<const T>& mat, Matrix<T>& res) {
+  filter(mat, res, FilterTag<F>());
 }
 
-template <>
-Matrix<> applyFilter<ARCV_FILTER_TYPE_EDGE_ENHANCEMENT>(Matrix<> mat) {
-  const Matrix<float> kernel = {{ 0.f,   1.f,  0.f },
-                                { 1.f,  -4.f,  1.f },
-                                { 0.f,   1.f,  0.f }};
+template <typename T>
+void medianBlur(const MatrixView<const T>& mat, Matrix<T>& res, std::size_t kernelSize) {
+  assert(("Error: Median filter kernel's size must be odd", kernelSize % 2 == 1));
+  assert(("Error: Median filter cannot be applied in place",
+          static_cast<const void*>(res.getData().data()) != static_cast<const void*>(mat.getData())));
 
-  return mat.convolve(kernel);
+  res.reshape(mat.getWidth(), mat.getHeight(), mat.getChannelCount(), mat.getImgBitDepth(), mat.getColorspace(), res.hasPaddedRows());
+
+  if (mat.getWidth() == 0 || mat.getHeight() == 0)
+    return;
+
+  if (kernelSize <= 5)
+    computeWindowMedians(mat, res.getView(), kernelSize);
+  else
+    computeLargeMedians(mat, res.getView(), kernelSize);
 }
 
-template <>
-Matrix<> applyFilter<ARCV_FILTER_TYPE_EMBOSS>(Matrix<> mat) {
-  const Matrix<float> kernel = {{ -2.f, -1.f, 0.f },
-                                { -1.f,  1.f, 1.f },
-                                {  0.f,  1.f, 2.f }};
+template <typename T>
+void bilateralFilter(const MatrixView<const T>& mat, Matrix<T>& res, float sigmaSpace, float sigmaRange) {
+  assert(("Error: Bilateral filter's spatial standard deviation must be at least 1", sigmaSpace >= 1.f));
+  assert(("Error: Bilateral filter's range standard deviation must be positive", sigmaRange > 0.f));
+  assert(("Error: Bilateral filter cannot be applied in place",
+          static_cast<const void*>(res.getData().data()) != static_cast<const void*>(mat.getData())));
+
+  const std::size_t width = mat.getWidth();
+  const std::size_t height = mat.getHeight();
+  const std::size_t channelCount = mat.getChannelCount();
+
+  res.reshape(width, height, mat.getChannelCount(), mat.getImgBitDepth(), mat.getColorspace(), res.hasPaddedRows());
+
+  if (width == 0 || height == 0)
+    return;
+
+  // Elements are placed along the range by the mean of their channels
+  std::vector<float> rangeValues(width * height);
+
+  dispatchChannelCount(mat.getChannelCount(), [&] (auto channels) {
+    const uint8_t channelCount = channels(mat.getChannelCount());
+    const float channelScale = 1.f / static_cast<float>(channelCount);
+
+    ThreadPool::getInstance().parallelFor(height, [&] (std::size_t begin, std::size_t end) {
+      for (std::size_t rowIndex = begin; rowIndex < end; ++rowIndex) {
+        const T* row = mat.getRow(rowIndex);
+
+        for (std::size_t columnIndex = 0; columnIndex < width; ++columnIndex) {
+          float sum = 0.f;
+          for (uint8_t chan = 0; chan < channelCount; ++chan)
+            sum += row[columnIndex * channelCount + chan];
+
+          rangeValues[rowIndex * width + columnIndex] = sum * channelScale;
+        }
+      }
+    });
+  });
+
+  const auto rangeBounds = std::minmax_element(rangeValues.cbegin(), rangeValues.cend());
+  const float rangeMin = *rangeBounds.first;
+  const float spaceScale = 1.f / sigmaSpace;
+  const float rangeScale = 1.f / sigmaRange;
+  const float padding = static_cast<float>(BilateralGrid::Padding);
+
+  BilateralGrid grid(static_cast<std::size_t>(static_cast<float>(width - 1) * spaceScale + 0.5f) + 1 + 2 * BilateralGrid::Padding,
+                     static_cast<std::size_t>(static_cast<float>(height - 1) * spaceScale + 0.5f) + 1 + 2 * BilateralGrid::Padding,
+                     static_cast<std::size_t>((*rangeBounds.second - rangeMin) * rangeScale + 0.5f) + 1 + 2 * BilateralGrid::Padding,
+                     channelCount);
+
+  // Positions in the grid, of both the nearest cell & the cells around, are computed once for all columns & rows
+  const auto getGridPosition = [padding] (float position) { return position + padding; };
+  const auto getGridIndex = [] (float gridPosition) { return static_cast<std::size_t>(static_cast<uint32_t>(gridPosition)); };
+
+  std::vector<std::size_t> nearestGridColumns(width);
+  std::vector<std::size_t> gridColumns(width);
+  std::vector<float> columnWeights(width);
+
+  for (std::size_t columnIndex = 0; columnIndex < width; ++columnIndex) {
+    const float gridColumn = getGridPosition(static_cast<float>(columnIndex) * spaceScale);
+
+    nearestGridColumns[columnIndex] = getGridIndex(gridColumn + 0.5f);
+    gridColumns[columnIndex] = getGridIndex(gridColumn);
+    columnWeights[columnIndex] = gridColumn - static_cast<float>(gridColumns[columnIndex]);
+  }
+
+  dispatchChannelCount(mat.getChannelCount(), [&] (auto channels) {
+    const uint8_t channelCount = channels(mat.getChannelCount());
+
+    // Elements are accumulated into their nearest cell, each thread filling its own rows of the grid
+    ThreadPool::getInstance().parallelFor(grid.height, [&] (std::size_t begin, std::size_t end) {
+      for (std::size_t rowIndex = 0; rowIndex < height; ++rowIndex) {
+        const std::size_t gridRowIndex = getGridIndex(getGridPosition(static_cast<float>(rowIndex) * spaceScale) + 0.5f);
+
+        if (gridRowIndex < begin || gridRowIndex >= end)
+          continue;
+
+        const T* row = mat.getRow(rowIndex);
+        const float* rowRangeValues = rangeValues.data() + rowIndex * width;
+
+        for (std::size_t columnIndex = 0; columnIndex < width; ++columnIndex) {
+          float* cell = grid.getCell(nearestGridColumns[columnIndex], gridRowIndex,
+                                     getGridIndex(getGridPosition((rowRangeValues[columnIndex] - rangeMin) * rangeScale) + 0.5f));
 
-  return mat.convolve(kernel);
+          for (uint8_t chan = 0; chan < channelCount; ++chan)
+            cell[chan] += row[columnIndex * channelCount + chan];
+          cell[channelCount] += 1.f;
+        }
+      }
+    });
+  });
+
+  std::vector<float> blurredValues;
+  blurBilateralGrid(grid, blurredValues, grid.cellSize);
+  blurBilateralGrid(grid, blurredValues, grid.getColumnStride());
+  blurBilateralGrid(grid, blurredValues, grid.getRowStride());
+
+  // Every element takes the trilinear interpolation of the cells around its position, normalized by their count
+  const MatrixView<T> resView = res.getView();
+  const std::size_t columnStride = grid.getColumnStride();
+  const std::size_t rowStride = grid.getRowStride();
+
+  dispatchChannelCount(mat.getChannelCount(), [&] (auto channels) {
+    const uint8_t channelCount = channels(mat.getChannelCount());
+
+    ThreadPool::getInstance().parallelFor(height, [&] (std::size_t begin, std::size_t end) {
+      std::vector<float> sums(channelCount + 1);
+
+      for (std::size_t rowIndex = begin; rowIndex < end; ++rowIndex) {
+        const float gridRow = getGridPosition(static_cast<float>(rowIndex) * spaceScale);
+        const std::size_t gridRowIndex = getGridIndex(gridRow);
+        const float rowWeight = gridRow - static_cast<float>(gridRowIndex);
+
+        const T* row = mat.getRow(rowIndex);
+        const float* rowRangeValues = rangeValues.data() + rowIndex * width;
+        T* resRow = resView.getRow(rowIndex);
+
+        for (std::size_t columnIndex = 0; columnIndex < width; ++columnIndex) {
+          const float gridDepth = getGridPosition((rowRangeValues[columnIndex] - rangeMin) * rangeScale);
+          const std::size_t gridDepthIndex = getGridIndex(gridDepth);
+          const float depthWeight = gridDepth - static_cast<float>(gridDepthIndex);
+          const float columnWeight = columnWeights[columnIndex];
+          const float* cells = grid.getCell(gridColumns[columnIndex], gridRowIndex, gridDepthIndex);
+
+          const float weights[] = { (1.f - rowWeight) * (1.f - columnWeight), (1.f - rowWeight) * columnWeight,
+                                    rowWeight * (1.f - columnWeight), rowWeight * columnWeight };
+          const std::size_t offsets[] = { 0, columnStride, rowStride, rowStride + columnStride };
+
+          std::fill(sums.begin(), sums.end(), 0.f);
+
+          for (std::size_t cornerIndex = 0; cornerIndex < 4; ++cornerIndex) {
+            const float* lowCell = cells + offsets[cornerIndex];
+            const float* highCell = lowCell + channelCount + 1;
+            const float lowWeight = weights[cornerIndex] * (1.f - depthWeight);
+            const float highWeight = weights[cornerIndex] * depthWeight;
+
+            for (uint8_t valueIndex = 0; valueIndex <= channelCount; ++valueIndex)
+              sums[valueIndex] += lowWeight * lowCell[valueIndex] + highWeight * highCell[valueIndex];
+          }
+
+          // The element's own cells always hold some weight, unless the interpolation lost it to rounding
+          const float countScale = (sums[channelCount] > 0.f ? 1.f / sums[channelCount] : 0.f);
+
+          for (uint8_t chan = 0; chan < channelCount; ++chan) {
+            const std::size_t eltIndex = columnIndex * channelCount + chan;
+            resRow[eltIndex] = (countScale > 0.f ? convertBlurredValue<T>(sums[chan] * countScale) : row[eltIndex]);
+          }
+        }
+      }
+    });
+  });
+}
+
+template <typename T>
+void guidedFilter(const MatrixView<const T>& mat, const MatrixView<const T>& guide, Matrix<T>& res, std::size_t radius,
+                  float epsilon, std::size_t subsampling) {
+  assert(("Error: Guide must have the same size as the matrix", guide.getWidth() == mat.getWidth() && guide.getHeight() == mat.getHeight()));
+  assert(("Error: Guide must have either one channel or as many as the matrix",
+          guide.getChannelCount() == 1 || guide.getChannelCount() == mat.getChannelCount()));
+  assert(("Error: Guided filter's subsampling factor must be at least 1", subsampling >= 1));
+  assert(("Error: Guided filter cannot be applied in place",
+          static_cast<const void*>(res.getData().data()) != static_cast<const void*>(mat.getData())
+          && static_cast<const void*>(res.getData().data()) != static_cast<const void*>(guide.getData())));
+
+  const std::size_t width = mat.getWidth();
+  const std::size_t height = mat.getHeight();
+  const std::size_t channelCount = mat.getChannelCount();
+  const std::size_t guideChannelCount = guide.getChannelCount();
+  const bool isSelfGuided = (guide.getData() == mat.getData() && guide.getRowStride() == mat.getRowStride()
+                             && guideChannelCount == channelCount);
+
+  res.reshape(width, height, mat.getChannelCount(), mat.getImgBitDepth(), mat.getColorspace(), res.hasPaddedRows());
+
+  if (width == 0 || height == 0)
+    return;
+
+  // Transforms are fitted on the downsampled matrices, over windows shrunk accordingly
+  Matrix<float> guideValues;
+  downsample(guide, subsampling, guideValues);
+
+  const std::size_t downsampledWidth = guideValues.getWidth();
+  const std::size_t downsampledHeight = guideValues.getHeight();
+  const std::size_t kernelSize = 2 * ((radius + subsampling / 2) / subsampling) + 1;
+
+  Matrix<float> guideMeans;
+  Matrix<float> guideVariances;
+  computeLocalStatistics(MatrixView<const float>(guideValues), kernelSize, kernelSize, guideMeans, guideVariances, ARCV_BORDER_TYPE_REPLICATE);
+
+  // Each channel's transform (a, b) is interleaved with the others', so that all of them get averaged at once
+  Matrix<float> coefficients(downsampledWidth, downsampledHeight, static_cast<uint8_t>(2 * channelCount), mat.getImgBitDepth(),
+                             mat.getColorspace());
+  Matrix<float> values;
+  Matrix<float> valueMeans;
+
+  if (!isSelfGuided) {
+    downsample(mat, subsampling, values);
+
+    // Matrix's values & their products with the guide, interleaved as well
+    Matrix<float> products(downsampledWidth, downsampledHeight, static_cast<uint8_t>(2 * channelCount), mat.getImgBitDepth(),
+                           mat.getColorspace());
+
+    ThreadPool::getInstance().parallelFor(downsampledHeight, [&] (std::size_t begin, std::size_t end) {
+      for (std::size_t rowIndex = begin; rowIndex < end; ++rowIndex) {
+        const float* row = values.getView().getRow(rowIndex);
+        const float* guideRow = guideValues.getView().getRow(rowIndex);
+        float* productRow = products.getView().getRow(rowIndex);
+
+        for (std::size_t columnIndex = 0; columnIndex < downsampledWidth; ++columnIndex) {
+          for (std::size_t chan = 0; chan < channelCount; ++chan) {
+            const float value = row[columnIndex * channelCount + chan];
+            const float guideValue = guideRow[columnIndex * guideChannelCount + (guideChannelCount == 1 ? 0 : chan)];
+
+            productRow[(columnIndex * channelCount + chan) * 2] = value;
+            productRow[(columnIndex * channelCount + chan) * 2 + 1] = value * guideValue;
+          }
+        }
+      }
+    });
+
+    boxFilter(MatrixView<const float>(products), kernelSize, kernelSize, valueMeans, ARCV_BORDER_TYPE_REPLICATE);
+  }
+
+  ThreadPool::getInstance().parallelFor(downsampledHeight, [&] (std::size_t begin, std::size_t end) {
+    for (std::size_t rowIndex = begin; rowIndex < end; ++rowIndex) {
+      const float* meanRow = guideMeans.getView().getRow(rowIndex);
+      const float* varianceRow = guideVariances.getView().getRow(rowIndex);
+      float* coefficientRow = coefficients.getView().getRow(rowIndex);
+
+      for (std::size_t columnIndex = 0; columnIndex < downsampledWidth; ++columnIndex) {
+        for (std::size_t chan = 0; chan < channelCount; ++chan) {
+          const std::size_t guideIndex = columnIndex * guideChannelCount + (guideChannelCount == 1 ? 0 : chan);
+          const std::size_t eltIndex = columnIndex * channelCount + chan;
+          float valueMean = meanRow[guideIndex];
+          float covariance = varianceRow[guideIndex];
+
+          // A self-guided window's covariance is its variance
+          if (!isSelfGuided) {
+            const float* valueMeanRow = valueMeans.getView().getRow(rowIndex);
+
+            valueMean = valueMeanRow[eltIndex * 2];
+            covariance = valueMeanRow[eltIndex * 2 + 1] - meanRow[guideIndex] * valueMean;
+          }
+
+          const float slope = covariance / (varianceRow[guideIndex] + epsilon);
+
+          coefficientRow[eltIndex * 2] = slope;
+          coefficientRow[eltIndex * 2 + 1] = valueMean - slope * meanRow[guideIndex];
+        }
+      }
+    }
+  });
+
+  // Every element is given the mean of the transforms fitted on the windows covering it
+  Matrix<float> coefficientMeans;
+  boxFilter(MatrixView<const float>(coefficients), kernelSize, kernelSize, coefficientMeans, ARCV_BORDER_TYPE_REPLICATE);
+
+  const UpsamplingTaps columnTaps(width, downsampledWidth, subsampling);
+  const UpsamplingTaps rowTaps(height, downsampledHeight, subsampling);
+  const MatrixView<const float> meansView(coefficientMeans);
+  const MatrixView<T> resView = res.getView();
+  const std::size_t coefficientCount = 2 * channelCount;
+
+  ThreadPool::getInstance().parallelFor(height, [&] (std::size_t begin, std::size_t end) {
+    std::vector<float> rowCoefficients(downsampledWidth * coefficientCount);
+
+    for (std::size_t rowIndex = begin; rowIndex < end; ++rowIndex) {
+      const float* firstRow = meansView.getRow(rowTaps.firstIndices[rowIndex]);
+      const float* secondRow = meansView.getRow(rowTaps.secondIndices[rowIndex]);
+      const float rowWeight = rowTaps.weights[rowIndex];
+
+      for (std::size_t coefficientIndex = 0; coefficientIndex < rowCoefficients.size(); ++coefficientIndex)
+        rowCoefficients[coefficientIndex] = firstRow[coefficientIndex] + (secondRow[coefficientIndex] - firstRow[coefficientIndex]) * rowWeight;
+
+      const T* guideRow = guide.getRow(rowIndex);
+      T* resRow = resView.getRow(rowIndex);
+
+      for (std::size_t columnIndex = 0; columnIndex < width; ++columnIndex) {
+        const float* firstCoefficients = rowCoefficients.data() + columnTaps.firstIndices[columnIndex] * coefficientCount;
+        const float* secondCoefficients = rowCoefficients.data() + columnTaps.secondIndices[columnIndex] * coefficientCount;
+        const float columnWeight = columnTaps.weights[columnIndex];
+
+        for (std::size_t chan = 0; chan < channelCount; ++chan) {
+          const float slope = firstCoefficients[chan * 2] + (secondCoefficients[chan * 2] - firstCoefficients[chan * 2]) * columnWeight;
+          const float offset = firstCoefficients[chan * 2 + 1]
+                             + (secondCoefficients[chan * 2 + 1] - firstCoefficients[chan * 2 + 1]) * columnWeight;
+          const float guideValue = guideRow[columnIndex * guideChannelCount + (guideChannelCount == 1 ? 0 : chan)];
+
+          resRow[columnIndex * channelCount + chan] = convertBlurredValue<T>(slope * guideValue + offset);
+        }
+      }
+    }
+  });
 }
 
+template void applyFilter<ARCV_FILTER_TYPE_GAUSSIAN_BLUR>(const MatrixView<const float>& mat, Matrix<float>& res);
+template void applyFilter<ARCV_FILTER_TYPE_GAUSSIAN_BLUR>(const MatrixView<const uint8_t>& mat, Matrix<uint8_t>& res);
+template void applyFilter<ARCV_FILTER_TYPE_GAUSSIAN_BLUR>(const MatrixView<const int16_t>& mat, Matrix<int16_t>& res);
+template void applyFilter<ARCV_FILTER_TYPE_SHARPEN>(const MatrixView<const float>& mat, Matrix<float>& res);
+template void applyFilter<ARCV_FILTER_TYPE_SHARPEN>(const MatrixView<const uint8_t>& mat, Matrix<uint8_t>& res);
+template void applyFilter<ARCV_FILTER_TYPE_SHARPEN>(const MatrixView<const int16_t>& mat, Matrix<int16_t>& res);
+template void applyFilter<ARCV_FILTER_TYPE_EDGE_ENHANCEMENT>(const MatrixView<const float>& mat, Matrix<float>& res);
+template void applyFilter<ARCV_FILTER_TYPE_EDGE_ENHANCEMENT>(const MatrixView<const uint8_t>& mat, Matrix<uint8_t>& res);
+template void applyFilter<ARCV_FILTER_TYPE_EDGE_ENHANCEMENT>(const MatrixView<const int16_t>& mat, Matrix<int16_t>& res);
+template void applyFilter<ARCV_FILTER_TYPE_EMBOSS>(const MatrixView<const float>& mat, Matrix<float>& res);
+template void applyFilter<ARCV_FILTER_TYPE_EMBOSS>(const MatrixView<const uint8_t>& mat, Matrix<uint8_t>& res);
+template void applyFilter<ARCV_FILTER_TYPE_EMBOSS>(const MatrixView<const int16_t>& mat, Matrix<int16_t>& res);
+
+template void gaussianBlur(const MatrixView<const float>& mat, Matrix<float>& res, float sigmaX, float sigmaY);
+template void gaussianBlur(const MatrixView<const uint8_t>& mat, Matrix<uint8_t>& res, float sigmaX, float sigmaY);
+template void gaussianBlur(const MatrixView<const int16_t>& mat, Matrix<int16_t>& res, float sigmaX, float sigmaY);
+
+template void medianBlur(const MatrixView<const float>& mat, Matrix<float>& res, std::size_t kernelSize);
+template void medianBlur(const MatrixView<const uint8_t>& mat, Matrix<uint8_t>& res, std::size_t kernelSize);
+template void medianBlur(const MatrixView<const int16_t>& mat, Matrix<int16_t>& res, std::size_t kernelSize);
+
+template void bilateralFilter(const MatrixView<const float>& mat, Matrix<float>& res, float sigmaSpace, float sigmaRange);
+template void bilateralFilter(const MatrixView<const uint8_t>& mat, Matrix<uint8_t>& res, float sigmaSpace, float sigmaRange);
+template void bilateralFilter(const MatrixView<const int16_t>& mat, Matrix<int16_t>& res, float sigmaSpace, float sigmaRange);
+
+template void guidedFilter(const MatrixView<const float>& mat, const MatrixView<const float>& guide, Matrix<float>& res,
+                           std::size_t radius, float epsilon, std::size_t subsampling);
+template void guidedFilter(const MatrixView<const uint8_t>& mat, const MatrixView<const uint8_t>& guide, Matrix<uint8_t>& res,
+                           std::size_t radius, float epsilon, std::size_t subsampling);
+template void guidedFilter(const MatrixView<const int16_t>& mat, const MatrixView<const int16_t>& guide, Matrix<int16_t>& res,
+                           std::size_t radius, float epsilon, std::size_t subsampling);
+
 } // namespace Image
 
 } // namespace Arcv
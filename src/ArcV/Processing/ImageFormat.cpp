@@ -26,11 +26,11 @@ bool validatePng(std::istream& file) {
   return (png_sig_cmp(header.data(), 0, PNG_HEADER_SIZE) == 0);
 }
 
-Matrix<> readJpeg(std::ifstream& file) {
+Matrix<uint8_t> readJpeg(std::ifstream& file) {
   throw std::runtime_error("Error: JPEG reading not yet implemented");
 }
 
-Matrix<> readPng(std::ifstream& file) {
+Matrix<uint8_t> readPng(std::ifstream& file) {
   if (!validatePng(file))
     throw std::runtime_error("Error: Not a valid PNG");
 
@@ -105,33 +105,32 @@ Matrix<> readPng(std::ifstream& file) {
 
   // Mapping row's elements to data's
   for (unsigned int i = 0; i < height; ++i)
-    rowPtrs[i] = &mat.getData()[width * channels * i];
+    rowPtrs[i] = &mat.getData()[mat.getStride() * i];
 
   png_read_image(readStruct, rowPtrs.data());
   png_read_end(readStruct, infoStruct);
   png_destroy_read_struct(&readStruct, nullptr, &infoStruct);
 
-  return Matrix<>(mat);
+  return mat;
 }
 
-Matrix<> readTga(std::ifstream& file) {
+Matrix<uint8_t> readTga(std::ifstream& file) {
   throw std::runtime_error("Error: TGA reading not yet implemented");
 }
 
-Matrix<> readBmp(std::ifstream& file) {
+Matrix<uint8_t> readBmp(std::ifstream& file) {
   throw std::runtime_error("Error: BMP reading not yet implemented");
 }
 
-Matrix<> readBpg(std::ifstream& file) {
+Matrix<uint8_t> readBpg(std::ifstream& file) {
   throw std::runtime_error("Error: BPG reading not yet implemented");
 }
 
-void writeJpeg(const Matrix<>& mat, std::ofstream& file) {
+void writeJpeg(const Matrix<uint8_t>& mat, std::ofstream& file) {
   throw std::runtime_error("Error: JPEG output not yet implemented");
 }
 
-void writePng(const Matrix<>& mat, std::ofstream& file) {
-  const Matrix<uint8_t> matToWrite(mat);
+void writePng(const Matrix<uint8_t>& matToWrite, std::ofstream& file) {
 
   png_structp writeStruct = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
   if (!writeStruct)
@@ -188,27 +187,28 @@ void writePng(const Matrix<>& mat, std::ofstream& file) {
   png_write_info(writeStruct, infoStruct);
 
   for (std::size_t i = 0; i < matToWrite.getHeight(); ++i)
-    png_write_row(writeStruct, &matToWrite.getData()[matToWrite.getWidth() * matToWrite.getChannelCount() * i]);
+    png_write_row(writeStruct, &matToWrite.getData()[matToWrite.getStride() * i]);
 
   png_write_end(writeStruct, infoStruct);
   png_destroy_write_struct(&writeStruct, &infoStruct);
 }
 
-void writeTga(const Matrix<>& mat, std::ofstream& file) {
+void writeTga(const Matrix<uint8_t>& mat, std::ofstream& file) {
   throw std::runtime_error("Error: TGA output not yet implemented");
 }
 
-void writeBmp(const Matrix<>& mat, std::ofstream& file) {
+void writeBmp(const Matrix<uint8_t>& mat, std::ofstream& file) {
   throw std::runtime_error("Error: BMP output not yet implemented");
 }
 
-void writeBpg(const Matrix<>& mat, std::ofstream& file) {
+void writeBpg(const Matrix<uint8_t>& mat, std::ofstream& file) {
   throw std::runtime_error("Error: BPG output not yet implemented");
 }
 
 } // namespace
 
-Matrix<> read(const std::string& fileName) {
+template <>
+Matrix<uint8_t> read(const std::string& fileName) {
   std::ifstream file(fileName, std::ios_base::in | std::ios_base::binary);
 
   if (file) {
@@ -231,7 +231,8 @@ Matrix<> read(const std::string& fileName) {
   }
 }
 
-void write(const Matrix<>& mat, const std::string& fileName) {
+template <>
+void write(const Matrix<uint8_t>& mat, const std::string& fileName) {
   std::ofstream file(fileName, std::ios_base::out | std::ios_base::binary);
   const std::string format = extractFileExt(fileName);
 
@@ -249,6 +250,22 @@ void write(const Matrix<>& mat, const std::string& fileName) {
     throw std::runtime_error("Error: '" + format + "' format is not supported");
 }
 
+// Files are always decoded into & encoded from 8-bit pixels, other types being converted
+template <typename T>
+Matrix<T> read(const std::string& fileName) {
+  return Matrix<T>(read<uint8_t>(fileName));
+}
+
+template <typename T>
+void write(const Matrix<T>& mat, const std::string& fileName) {
+  write(Matrix<uint8_t>(mat), fileName);
+}
+
+template Matrix<float> read<float>(const std::string& fileName);
+template Matrix<int16_t> read<int16_t>(const std::string& fileName);
+template void write(const Matrix<float>& mat, const std::string& fileName);
+template void write(const Matrix<int16_t>& mat, const std::string& fileName);
+
 } // namespace Image
 
 } // namespace Arcv
@@ -0,0 +1,429 @@
+#include <vector>
+#include <algorithm>
+
+#include "ArcV/Math/Simd.hpp"
+#include "ArcV/Math/BitMatrix.hpp"
+#include "ArcV/Processing/Image.hpp"
+#include "ArcV/Utils/ThreadPool.hpp"
+
+namespace Arcv {
+
+namespace Image {
+
+namespace {
+
+template <MorphologyType M> using MorphologyTag = std::integral_constant<MorphologyType, M>;
+
+// Extrema taken by erosions & dilations, between two elements & between two rows of them
+template <typename T>
+struct Minimum {
+  static T compute(T lhs, T rhs) { return (lhs < rhs ? lhs : rhs); }
+  static void computeRows(const T* lhs, const T* rhs, T* res, std::size_t count) { Simd::computeMinimums(lhs, rhs, res, count); }
+};
+
+template <typename T>
+struct Maximum {
+  static T compute(T lhs, T rhs) { return (lhs > rhs ? lhs : rhs); }
+  static void computeRows(const T* lhs, const T* rhs, T* res, std::size_t count) { Simd::computeMaximums(lhs, rhs, res, count); }
+};
+
+// Packed elements' minimum is their intersection & their maximum their union; the elements outside of a mask are given
+//  the value leaving the others unchanged, which is the same as replicating its edges
+struct BitMinimum {
+  static constexpr uint64_t Outside = ~uint64_t(0);
+
+  static uint64_t compute(uint64_t lhs, uint64_t rhs) { return lhs & rhs; }
+  static void computeRows(const uint64_t* lhs, const uint64_t* rhs, uint64_t* res, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i)
+      res[i] = lhs[i] & rhs[i];
+  }
+};
+
+struct BitMaximum {
+  static constexpr uint64_t Outside = 0;
+
+  static uint64_t compute(uint64_t lhs, uint64_t rhs) { return lhs | rhs; }
+  static void computeRows(const uint64_t* lhs, const uint64_t* rhs, uint64_t* res, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i)
+      res[i] = lhs[i] | rhs[i];
+  }
+};
+
+constexpr uint64_t BitMinimum::Outside;
+constexpr uint64_t BitMaximum::Outside;
+
+// Van Herk & Gil-Werman's pass across rows: the rows, extended by radius replicated ones on both sides, are cut into
+//  blocks of kernelSize; suffixes accumulate the extremum of a block's rows from its last one & prefixes from its first
+//  one, the extremum of the kernelSize rows starting at any row being that of its block's suffix & of the next block's
+//  prefix ending kernelSize - 1 rows further. Each thread sweeps its own rows, keeping a block of suffixes & one prefix
+template <typename Extremum, typename T, typename InputRowFunc, typename ResRowFunc>
+void applyColumnPass(std::size_t rowCount, std::size_t rowLength, std::size_t kernelSize,
+                     InputRowFunc getInputRow, ResRowFunc getResRow) {
+  const std::ptrdiff_t radius = static_cast<std::ptrdiff_t>(kernelSize - 1) / 2;
+
+  ThreadPool::getInstance().parallelFor(rowCount, [&] (std::size_t begin, std::size_t end) {
+    std::vector<T> suffixes((kernelSize - 1) * rowLength);
+    std::vector<T> prefix(rowLength);
+    std::vector<const T*> suffixRows(kernelSize);
+
+    // Rows are indexed from the first one of the first output row's neighbourhood
+    const auto getExtendedRow = [&] (std::size_t extendedIndex) {
+      const std::ptrdiff_t rowIndex = static_cast<std::ptrdiff_t>(begin + extendedIndex) - radius;
+      return getInputRow(static_cast<std::size_t>(std::min(std::max<std::ptrdiff_t>(rowIndex, 0),
+                                                           static_cast<std::ptrdiff_t>(rowCount) - 1)));
+    };
+
+    for (std::size_t blockBegin = 0; begin + blockBegin < end; blockBegin += kernelSize) {
+      suffixRows[kernelSize - 1] = getExtendedRow(blockBegin + kernelSize - 1);
+
+      for (std::size_t blockIndex = kernelSize - 1; blockIndex-- > 0;) {
+        T* suffixRow = suffixes.data() + blockIndex * rowLength;
+        Extremum::computeRows(getExtendedRow(blockBegin + blockIndex), suffixRows[blockIndex + 1], suffixRow, rowLength);
+        suffixRows[blockIndex] = suffixRow;
+      }
+
+      // The first row's neighbourhood is exactly the block
+      std::copy(suffixRows[0], suffixRows[0] + rowLength, getResRow(begin + blockBegin));
+
+      const T* prefixRow = getExtendedRow(blockBegin + kernelSize);
+
+      for (std::size_t blockIndex = 1; blockIndex < kernelSize && begin + blockBegin + blockIndex < end; ++blockIndex) {
+        if (blockIndex > 1) {
+          Extremum::computeRows(prefixRow, getExtendedRow(blockBegin + kernelSize + blockIndex - 1), prefix.data(), rowLength);
+          prefixRow = prefix.data();
+        }
+
+        Extremum::computeRows(suffixRows[blockIndex], prefixRow, getResRow(begin + blockBegin + blockIndex), rowLength);
+      }
+    }
+  });
+}
+
+// Same pass along each row, in place: the row is copied with its replicated edges, scanned by blocks of kernelSize
+//  pixels, the prefixes & suffixes of which are then combined by vectors. Channels are independent, pixels' elements
+//  being channelCount apart
+template <typename Extremum, typename T>
+void applyRowPass(const MatrixView<T>& mat, std::size_t kernelSize) {
+  const std::size_t radius = (kernelSize - 1) / 2;
+  const std::size_t channelCount = mat.getChannelCount();
+  const std::size_t rowLength = mat.getRowLength();
+  const std::size_t extendedWidth = mat.getWidth() + 2 * radius;
+
+  ThreadPool::getInstance().parallelFor(mat.getHeight(), [&] (std::size_t begin, std::size_t end) {
+    std::vector<T> extendedRow(extendedWidth * channelCount);
+    std::vector<T> prefixes(extendedRow.size());
+    std::vector<T> suffixes(extendedRow.size());
+
+    for (std::size_t rowIndex = begin; rowIndex < end; ++rowIndex) {
+      T* row = mat.getRow(rowIndex);
+
+      std::copy(row, row + rowLength, extendedRow.data() + radius * channelCount);
+
+      for (std::size_t columnIndex = 0; columnIndex < radius; ++columnIndex) {
+        std::copy(row, row + channelCount, extendedRow.data() + columnIndex * channelCount);
+        std::copy(row + rowLength - channelCount, row + rowLength, extendedRow.end() - (columnIndex + 1) * channelCount);
+      }
+
+      for (std::size_t blockBegin = 0; blockBegin < extendedWidth; blockBegin += kernelSize) {
+        const std::size_t eltBegin = blockBegin * channelCount;
+        const std::size_t eltEnd = std::min(blockBegin + kernelSize, extendedWidth) * channelCount;
+
+        std::copy(extendedRow.data() + eltBegin, extendedRow.data() + eltBegin + channelCount, prefixes.data() + eltBegin);
+        for (std::size_t eltIndex = eltBegin + channelCount; eltIndex < eltEnd; ++eltIndex)
+          prefixes[eltIndex] = Extremum::compute(prefixes[eltIndex - channelCount], extendedRow[eltIndex]);
+
+        std::copy(extendedRow.data() + eltEnd - channelCount, extendedRow.data() + eltEnd, suffixes.data() + eltEnd - channelCount);
+        for (std::size_t eltIndex = eltEnd - channelCount; eltIndex-- > eltBegin;)
+          suffixes[eltIndex] = Extremum::compute(suffixes[eltIndex + channelCount], extendedRow[eltIndex]);
+      }
+
+      // A block's last prefix & first suffix both being its extremum, the neighbourhoods starting on a block are covered too
+      Extremum::computeRows(suffixes.data(), prefixes.data() + (kernelSize - 1) * channelCount, row, rowLength);
+    }
+  });
+}
+
+template <typename Extremum, typename T>
+void applyExtremumFilter(const MatrixView<const T>& mat, Matrix<T>& res, std::size_t kernelWidth, std::size_t kernelHeight) {
+  assert(("Error: Morphological kernel's sizes must be odd", kernelWidth % 2 == 1 && kernelHeight % 2 == 1));
+  assert(("Error: Morphological filters cannot be applied in place",
+          static_cast<const void*>(res.getData().data()) != static_cast<const void*>(mat.getData())));
+
+  res.reshape(mat.getWidth(), mat.getHeight(), mat.getChannelCount(), mat.getImgBitDepth(), mat.getColorspace(), res.hasPaddedRows());
+
+  if (mat.getWidth() == 0 || mat.getHeight() == 0)
+    return;
+
+  const MatrixView<T> resView = res.getView();
+  const std::size_t rowLength = mat.getRowLength();
+
+  // Rows are filtered in place once in the result
+  applyColumnPass<Extremum, T>(mat.getHeight(), rowLength, kernelHeight,
+                               [&mat] (std::size_t rowIndex) { return mat.getRow(rowIndex); },
+                               [&resView] (std::size_t rowIndex) { return resView.getRow(rowIndex); });
+
+  if (kernelWidth > 1)
+    applyRowPass<Extremum>(resView, kernelWidth);
+}
+
+// Integer results are saturated, int16_t ones possibly going beyond the type's range
+template <typename T>
+void subtractRows(const MatrixView<const T>& lhs, const Matrix<T>& rhs, Matrix<T>& res) {
+  const MatrixView<const T> rhsView = rhs.getView();
+  const MatrixView<T> resView = res.getView();
+
+  for (std::size_t rowIndex = 0; rowIndex < lhs.getHeight(); ++rowIndex) {
+    if (resView.getRow(rowIndex) != lhs.getRow(rowIndex))
+      std::copy(lhs.getRow(rowIndex), lhs.getRow(rowIndex) + lhs.getRowLength(), resView.getRow(rowIndex));
+
+    Simd::applyElementwise<ARCV_ELEMENTWISE_SUB>(resView.getRow(rowIndex), rhsView.getRow(rowIndex), lhs.getRowLength());
+  }
+}
+
+template <typename T>
+void computeMorphology(const MatrixView<const T>& mat, Matrix<T>& res, std::size_t kernelWidth, std::size_t kernelHeight,
+                       MorphologyTag<ARCV_MORPHOLOGY_TYPE_EROSION>) {
+  applyExtremumFilter<Minimum<T>>(mat, res, kernelWidth, kernelHeight);
+}
+
+template <typename T>
+void computeMorphology(const MatrixView<const T>& mat, Matrix<T>& res, std::size_t kernelWidth, std::size_t kernelHeight,
+                       MorphologyTag<ARCV_MORPHOLOGY_TYPE_DILATION>) {
+  applyExtremumFilter<Maximum<T>>(mat, res, kernelWidth, kernelHeight);
+}
+
+template <typename T>
+void computeMorphology(const MatrixView<const T>& mat, Matrix<T>& res, std::size_t kernelWidth, std::size_t kernelHeight,
+                       MorphologyTag<ARCV_MORPHOLOGY_TYPE_OPENING>) {
+  Matrix<T> erosion;
+  applyExtremumFilter<Minimum<T>>(mat, erosion, kernelWidth, kernelHeight);
+  applyExtremumFilter<Maximum<T>>(MatrixView<const T>(erosion), res, kernelWidth, kernelHeight);
+}
+
+template <typename T>
+void computeMorphology(const MatrixView<const T>& mat, Matrix<T>& res, std::size_t kernelWidth, std::size_t kernelHeight,
+                       MorphologyTag<ARCV_MORPHOLOGY_TYPE_CLOSING>) {
+  Matrix<T> dilation;
+  applyExtremumFilter<Maximum<T>>(mat, dilation, kernelWidth, kernelHeight);
+  applyExtremumFilter<Minimum<T>>(MatrixView<const T>(dilation), res, kernelWidth, kernelHeight);
+}
+
+template <typename T>
+void computeMorphology(const MatrixView<const T>& mat, Matrix<T>& res, std::size_t kernelWidth, std::size_t kernelHeight,
+                       MorphologyTag<ARCV_MORPHOLOGY_TYPE_TOP_HAT>) {
+  Matrix<T> opening;
+  computeMorphology(mat, opening, kernelWidth, kernelHeight, MorphologyTag<ARCV_MORPHOLOGY_TYPE_OPENING>());
+
+  res.reshape(mat.getWidth(), mat.getHeight(), mat.getChannelCount(), mat.getImgBitDepth(), mat.getColorspace(), res.hasPaddedRows());
+  subtractRows(mat, opening, res);
+}
+
+template <typename T>
+void computeMorphology(const MatrixView<const T>& mat, Matrix<T>& res, std::size_t kernelWidth, std::size_t kernelHeight,
+                       MorphologyTag<ARCV_MORPHOLOGY_TYPE_GRADIENT>) {
+  Matrix<T> erosion;
+  applyExtremumFilter<Minimum<T>>(mat, erosion, kernelWidth, kernelHeight);
+  applyExtremumFilter<Maximum<T>>(mat, res, kernelWidth, kernelHeight);
+
+  subtractRows(MatrixView<const T>(res), erosion, res);
+}
+
+// 64 elements of a row of packed bits starting at the given one, which can lie before or after the row, the elements
+//  outside of it being given by outside
+inline uint64_t extractWord(const uint64_t* row, std::size_t wordCount, std::ptrdiff_t bitIndex, uint64_t outside) {
+  constexpr std::ptrdiff_t WordBitCount = BitMatrix::WordBitCount;
+
+  const auto getWord = [&] (std::ptrdiff_t wordIndex) {
+    return (wordIndex >= 0 && wordIndex < static_cast<std::ptrdiff_t>(wordCount) ? row[wordIndex] : outside);
+  };
+
+  const std::ptrdiff_t wordIndex = (bitIndex >= 0 ? bitIndex / WordBitCount : -((WordBitCount - 1 - bitIndex) / WordBitCount));
+  const std::ptrdiff_t bitOffset = bitIndex - wordIndex * WordBitCount;
+
+  if (bitOffset == 0)
+    return getWord(wordIndex);
+  return (getWord(wordIndex) >> bitOffset) | (getWord(wordIndex + 1) << (WordBitCount - bitOffset));
+}
+
+// Along rows, the extremum of the n elements starting at each one is combined with the one n elements further, doubling
+//  n until the largest power of 2 not above kernelSize; neighbourhoods of kernelSize elements then overlap two of them.
+//  Rows are extended on their left by enough words to hold the radius elements preceding them
+template <typename Extremum>
+void applyBitRowPass(BitMatrix& mask, std::size_t kernelSize) {
+  constexpr std::size_t WordBitCount = BitMatrix::WordBitCount;
+
+  const std::size_t radius = (kernelSize - 1) / 2;
+  const std::size_t rowWordCount = mask.getRowWordCount();
+  const std::size_t paddingWordCount = (radius + WordBitCount - 1) / WordBitCount;
+  const std::size_t extendedWordCount = paddingWordCount + rowWordCount;
+  const uint64_t lastWordMask = mask.getLastWordMask();
+
+  ThreadPool::getInstance().parallelFor(mask.getHeight(), [&] (std::size_t begin, std::size_t end) {
+    std::vector<uint64_t> extremums(extendedWordCount);
+    std::vector<uint64_t> shiftedExtremums(extendedWordCount);
+
+    const auto combineShifted = [&] (std::size_t shift) {
+      for (std::size_t wordIndex = 0; wordIndex < extendedWordCount; ++wordIndex) {
+        shiftedExtremums[wordIndex] = Extremum::compute(extremums[wordIndex],
+                                                        extractWord(extremums.data(), extendedWordCount,
+                                                                    static_cast<std::ptrdiff_t>(wordIndex * WordBitCount + shift),
+                                                                    Extremum::Outside));
+      }
+
+      extremums.swap(shiftedExtremums);
+    };
+
+    for (std::size_t rowIndex = begin; rowIndex < end; ++rowIndex) {
+      uint64_t* row = mask.getRow(rowIndex);
+
+      std::fill_n(extremums.begin(), paddingWordCount, Extremum::Outside);
+      std::copy(row, row + rowWordCount, extremums.begin() + paddingWordCount);
+      extremums.back() = (extremums.back() & lastWordMask) | (Extremum::Outside & ~lastWordMask);
+
+      std::size_t extremumSize = 1;
+
+      for (; extremumSize * 2 <= kernelSize; extremumSize *= 2)
+        combineShifted(extremumSize);
+
+      if (extremumSize < kernelSize)
+        combineShifted(kernelSize - extremumSize);
+
+      // The neighbourhood of element i starts radius elements before it, i.e. at paddingWordCount * 64 + i - radius
+      for (std::size_t wordIndex = 0; wordIndex < rowWordCount; ++wordIndex) {
+        row[wordIndex] = extractWord(extremums.data(), extendedWordCount,
+                                     static_cast<std::ptrdiff_t>((paddingWordCount + wordIndex) * WordBitCount - radius),
+                                     Extremum::Outside);
+      }
+
+      row[rowWordCount - 1] &= lastWordMask;
+    }
+  });
+}
+
+template <typename Extremum>
+void applyBitExtremumFilter(const BitMatrix& mask, BitMatrix& res, std::size_t kernelWidth, std::size_t kernelHeight) {
+  assert(("Error: Morphological kernel's sizes must be odd", kernelWidth % 2 == 1 && kernelHeight % 2 == 1));
+  assert(("Error: Morphological filters cannot be applied in place", &res != &mask));
+
+  res.reshape(mask.getWidth(), mask.getHeight());
+
+  if (mask.getWidth() == 0 || mask.getHeight() == 0)
+    return;
+
+  applyColumnPass<Extremum, uint64_t>(mask.getHeight(), mask.getRowWordCount(), kernelHeight,
+                                      [&mask] (std::size_t rowIndex) { return mask.getRow(rowIndex); },
+                                      [&res] (std::size_t rowIndex) { return res.getRow(rowIndex); });
+
+  if (kernelWidth > 1)
+    applyBitRowPass<Extremum>(res, kernelWidth);
+}
+
+// Differences of masks keep the elements set in the first one only
+void subtractMasks(const BitMatrix& lhs, BitMatrix& res) {
+  for (std::size_t wordIndex = 0; wordIndex < res.getData().size(); ++wordIndex)
+    res.getData()[wordIndex] = lhs.getData()[wordIndex] & ~res.getData()[wordIndex];
+}
+
+void computeMorphology(const BitMatrix& mask, BitMatrix& res, std::size_t kernelWidth, std::size_t kernelHeight,
+                       MorphologyTag<ARCV_MORPHOLOGY_TYPE_EROSION>) {
+  applyBitExtremumFilter<BitMinimum>(mask, res, kernelWidth, kernelHeight);
+}
+
+void computeMorphology(const BitMatrix& mask, BitMatrix& res, std::size_t kernelWidth, std::size_t kernelHeight,
+                       MorphologyTag<ARCV_MORPHOLOGY_TYPE_DILATION>) {
+  applyBitExtremumFilter<BitMaximum>(mask, res, kernelWidth, kernelHeight);
+}
+
+void computeMorphology(const BitMatrix& mask, BitMatrix& res, std::size_t kernelWidth, std::size_t kernelHeight,
+                       MorphologyTag<ARCV_MORPHOLOGY_TYPE_OPENING>) {
+  BitMatrix erosion;
+  applyBitExtremumFilter<BitMinimum>(mask, erosion, kernelWidth, kernelHeight);
+  applyBitExtremumFilter<BitMaximum>(erosion, res, kernelWidth, kernelHeight);
+}
+
+void computeMorphology(const BitMatrix& mask, BitMatrix& res, std::size_t kernelWidth, std::size_t kernelHeight,
+                       MorphologyTag<ARCV_MORPHOLOGY_TYPE_CLOSING>) {
+  BitMatrix dilation;
+  applyBitExtremumFilter<BitMaximum>(mask, dilation, kernelWidth, kernelHeight);
+  applyBitExtremumFilter<BitMinimum>(dilation, res, kernelWidth, kernelHeight);
+}
+
+void computeMorphology(const BitMatrix& mask, BitMatrix& res, std::size_t kernelWidth, std::size_t kernelHeight,
+                       MorphologyTag<ARCV_MORPHOLOGY_TYPE_TOP_HAT>) {
+  computeMorphology(mask, res, kernelWidth, kernelHeight, MorphologyTag<ARCV_MORPHOLOGY_TYPE_OPENING>());
+  subtractMasks(mask, res);
+}
+
+void computeMorphology(const BitMatrix& mask, BitMatrix& res, std::size_t kernelWidth, std::size_t kernelHeight,
+                       MorphologyTag<ARCV_MORPHOLOGY_TYPE_GRADIENT>) {
+  BitMatrix dilation;
+  applyBitExtremumFilter<BitMaximum>(mask, dilation, kernelWidth, kernelHeight);
+  applyBitExtremumFilter<BitMinimum>(mask, res, kernelWidth, kernelHeight);
+
+  subtractMasks(dilation, res);
+}
+
+} // namespace
+
+template <MorphologyType M, typename T>
+void applyMorphology(const MatrixView<const T>& mat, Matrix<T>& res, std::size_t kernelWidth, std::size_t kernelHeight) {
+  computeMorphology(mat, res, kernelWidth, kernelHeight, MorphologyTag<M>());
+}
+
+template <MorphologyType M>
+void applyMorphology(const BitMatrix& mask, BitMatrix& res, std::size_t kernelWidth, std::size_t kernelHeight) {
+  computeMorphology(mask, res, kernelWidth, kernelHeight, MorphologyTag<M>());
+}
+
+template void applyMorphology<ARCV_MORPHOLOGY_TYPE_EROSION>(const MatrixView<const float>& mat, Matrix<float>& res,
+                                                            std::size_t kernelWidth, std::size_t kernelHeight);
+template void applyMorphology<ARCV_MORPHOLOGY_TYPE_EROSION>(const MatrixView<const uint8_t>& mat, Matrix<uint8_t>& res,
+                                                            std::size_t kernelWidth, std::size_t kernelHeight);
+template void applyMorphology<ARCV_MORPHOLOGY_TYPE_EROSION>(const MatrixView<const int16_t>& mat, Matrix<int16_t>& res,
+                                                            std::size_t kernelWidth, std::size_t kernelHeight);
+template void applyMorphology<ARCV_MORPHOLOGY_TYPE_DILATION>(const MatrixView<const float>& mat, Matrix<float>& res,
+                                                             std::size_t kernelWidth, std::size_t kernelHeight);
+template void applyMorphology<ARCV_MORPHOLOGY_TYPE_DILATION>(const MatrixView<const uint8_t>& mat, Matrix<uint8_t>& res,
+                                                             std::size_t kernelWidth, std::size_t kernelHeight);
+template void applyMorphology<ARCV_MORPHOLOGY_TYPE_DILATION>(const MatrixView<const int16_t>& mat, Matrix<int16_t>& res,
+                                                             std::size_t kernelWidth, std::size_t kernelHeight);
+template void applyMorphology<ARCV_MORPHOLOGY_TYPE_OPENING>(const MatrixView<const float>& mat, Matrix<float>& res,
+                                                            std::size_t kernelWidth, std::size_t kernelHeight);
+template void applyMorphology<ARCV_MORPHOLOGY_TYPE_OPENING>(const MatrixView<const uint8_t>& mat, Matrix<uint8_t>& res,
+                                                            std::size_t kernelWidth, std::size_t kernelHeight);
+template void applyMorphology<ARCV_MORPHOLOGY_TYPE_OPENING>(const MatrixView<const int16_t>& mat, Matrix<int16_t>& res,
+                                                            std::size_t kernelWidth, std::size_t kernelHeight);
+template void applyMorphology<ARCV_MORPHOLOGY_TYPE_CLOSING>(const MatrixView<const float>& mat, Matrix<float>& res,
+                                                            std::size_t kernelWidth, std::size_t kernelHeight);
+template void applyMorphology<ARCV_MORPHOLOGY_TYPE_CLOSING>(const MatrixView<const uint8_t>& mat, Matrix<uint8_t>& res,
+                                                            std::size_t kernelWidth, std::size_t kernelHeight);
+template void applyMorphology<ARCV_MORPHOLOGY_TYPE_CLOSING>(const MatrixView<const int16_t>& mat, Matrix<int16_t>& res,
+                                                            std::size_t kernelWidth, std::size_t kernelHeight);
+template void applyMorphology<ARCV_MORPHOLOGY_TYPE_TOP_HAT>(const MatrixView<const float>& mat, Matrix<float>& res,
+                                                            std::size_t kernelWidth, std::size_t kernelHeight);
+template void applyMorphology<ARCV_MORPHOLOGY_TYPE_TOP_HAT>(const MatrixView<const uint8_t>& mat, Matrix<uint8_t>& res,
+                                                            std::size_t kernelWidth, std::size_t kernelHeight);
+template void applyMorphology<ARCV_MORPHOLOGY_TYPE_TOP_HAT>(const MatrixView<const int16_t>& mat, Matrix<int16_t>& res,
+                                                            std::size_t kernelWidth, std::size_t kernelHeight);
+template void applyMorphology<ARCV_MORPHOLOGY_TYPE_GRADIENT>(const MatrixView<const float>& mat, Matrix<float>& res,
+                                                             std::size_t kernelWidth, std::size_t kernelHeight);
+template void applyMorphology<ARCV_MORPHOLOGY_TYPE_GRADIENT>(const MatrixView<const uint8_t>& mat, Matrix<uint8_t>& res,
+                                                             std::size_t kernelWidth, std::size_t kernelHeight);
+template void applyMorphology<ARCV_MORPHOLOGY_TYPE_GRADIENT>(const MatrixView<const int16_t>& mat, Matrix<int16_t>& res,
+                                                             std::size_t kernelWidth, std::size_t kernelHeight);
+template void applyMorphology<ARCV_MORPHOLOGY_TYPE_EROSION>(const BitMatrix& mask, BitMatrix& res, std::size_t kernelWidth,
+                                                            std::size_t kernelHeight);
+template void applyMorphology<ARCV_MORPHOLOGY_TYPE_DILATION>(const BitMatrix& mask, BitMatrix& res, std::size_t kernelWidth,
+                                                             std::size_t kernelHeight);
+template void applyMorphology<ARCV_MORPHOLOGY_TYPE_OPENING>(const BitMatrix& mask, BitMatrix& res, std::size_t kernelWidth,
+                                                            std::size_t kernelHeight);
+template void applyMorphology<ARCV_MORPHOLOGY_TYPE_CLOSING>(const BitMatrix& mask, BitMatrix& res, std::size_t kernelWidth,
+                                                            std::size_t kernelHeight);
+template void applyMorphology<ARCV_MORPHOLOGY_TYPE_TOP_HAT>(const BitMatrix& mask, BitMatrix& res, std::size_t kernelWidth,
+                                                            std::size_t kernelHeight);
+template void applyMorphology<ARCV_MORPHOLOGY_TYPE_GRADIENT>(const BitMatrix& mask, BitMatrix& res, std::size_t kernelWidth,
+                                                             std::size_t kernelHeight);
+
+} // namespace Image
+
+} // namespace Arcv
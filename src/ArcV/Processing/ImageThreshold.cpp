@@ -1,82 +1,260 @@
+#include <vector>
+#include <utility>
+#include <algorithm>
+
 #include "ArcV/Processing/Image.hpp"
+#include "ArcV/Utils/ScratchBuffer.hpp"
 
 namespace Arcv {
 
 namespace Image {
 
-template <>
-Matrix<> threshold<ARCV_THRESH_TYPE_BINARY>(const Matrix<>& mat, std::initializer_list<float> lowerBounds,
-                                                                 std::initializer_list<float> upperBounds) {
+namespace {
+
+template <ThreshType Thresh> using ThreshTag = std::integral_constant<ThreshType, Thresh>;
+
+// Values temporarily given by hysteresis thresholding to the elements between both bounds, not known yet to be edges,
+//  & to those found to be connected to strong edges, set to 255 once done; strong edges are then told apart from the
+//  connected ones, only the former having to be looked for while scanning
+constexpr int WeakEdgeValue = 1;
+constexpr int ConnectedEdgeValue = 2;
+using EdgePosition = std::pair<std::size_t, std::size_t>;
+using EdgeStack = std::vector<EdgePosition, AlignedAllocator<EdgePosition>>;
+
+// Tag of the per-thread stacks of edges, whose capacity is kept from a call to the next
+struct EdgeStackBuffer {};
+
+template <typename T>
+void computeThreshold(const Matrix<T>& mat, Matrix<T>& res, std::initializer_list<float> lowerBounds,
+                      std::initializer_list<float> upperBounds, ThreshTag<ARCV_THRESH_TYPE_BINARY>) {
   assert(("Error: The number of lower & upper boundaries must match each other", lowerBounds.size() == upperBounds.size()));
   assert(("Error: The number of boundaries must match channel count",
           lowerBounds.size() + upperBounds.size() == mat.getChannelCount() * 2));
 
-  Matrix<> res(mat.getWidth(), mat.getHeight(), 1, mat.getImgBitDepth(), ARCV_COLORSPACE_GRAY);
-  std::size_t resIndex = 0;
+  const std::size_t width = mat.getWidth();
+  const std::size_t height = mat.getHeight();
+  const std::size_t matStride = mat.getStride();
+  const uint8_t matChannelCount = mat.getChannelCount();
+  const bool inPlace = (&res == &mat);
 
-  for (auto elt = mat.getData().begin(); elt != mat.getData().end(); elt += mat.getChannelCount(), ++resIndex) {
-    bool inBounds = true;
+  // Shrinking in place must be done after thresholding, the memory to read being otherwise released
+  if (inPlace)
+    res.setChannelCount(1);
+  else
+    res.reshape(width, height, 1, mat.getImgBitDepth(), ARCV_COLORSPACE_GRAY, mat.hasPaddedRows());
 
-    for (uint8_t chan = 0; chan < mat.getChannelCount(); ++chan) {
-      const float val = *(elt + chan);
+  dispatchChannelCount(matChannelCount, [&] (auto channels) {
+    const uint8_t channelCount = channels(matChannelCount);
 
-      if (val < *(lowerBounds.begin() + chan) || val > *(upperBounds.begin() + chan))
-        inBounds = false;
-    }
+    for (std::size_t heightIndex = 0; heightIndex < height; ++heightIndex) {
+      const T* elt = mat.getData().data() + heightIndex * matStride;
+      T* resElt = res.getData().data() + heightIndex * res.getStride();
 
-    res[resIndex] = (inBounds ? 255 : 0);
-  }
+      for (std::size_t widthIndex = 0; widthIndex < width; ++widthIndex, elt += channelCount) {
+        bool inBounds = true;
 
-  return res;
+        for (uint8_t chan = 0; chan < channelCount; ++chan) {
+          const float val = *(elt + chan);
+
+          inBounds &= !(val < *(lowerBounds.begin() + chan) || val > *(upperBounds.begin() + chan));
+        }
+
+        resElt[widthIndex] = (inBounds ? 255 : 0);
+      }
+    }
+  });
+
+  res.reshape(width, height, 1, res.getImgBitDepth(), ARCV_COLORSPACE_GRAY, res.hasPaddedRows());
 }
 
-template <>
-Matrix<> threshold<ARCV_THRESH_TYPE_HYSTERESIS>(const Matrix<>& mat, std::initializer_list<float> lowerBounds,
-                                                                     std::initializer_list<float> upperBounds) {
+template <typename T>
+void computeThreshold(const Matrix<T>& mat, Matrix<T>& res, std::initializer_list<float> lowerBounds,
+                      std::initializer_list<float> upperBounds, ThreshTag<ARCV_THRESH_TYPE_HYSTERESIS>) {
   assert(("Error: There should be only one lower & one upper boundaries", lowerBounds.size() == 1 && upperBounds.size() == 1));
+  assert(("Error: Hysteresis thresholding cannot be done in place", &res != &mat));
+
+  // A single-channel input is already gray & doesn't need to be converted
+  Matrix<T> convertedMat(AlignedAllocator<T>(MemoryArena::getCurrent()));
+  if (mat.getChannelCount() != 1)
+    changeColorspace<ARCV_COLORSPACE_GRAY>(mat, convertedMat);
+  const Matrix<T>& temp = (mat.getChannelCount() != 1 ? convertedMat : mat);
+
+  const std::size_t width = temp.getWidth();
+  const std::size_t height = temp.getHeight();
+  const float lowerBound = *lowerBounds.begin();
+  const float upperBound = *upperBounds.begin();
+
+  res.reshape(width, height, 1, temp.getImgBitDepth(), ARCV_COLORSPACE_GRAY, temp.hasPaddedRows());
+
+  if (width == 0 || height == 0)
+    return;
+
+  const std::size_t resStride = res.getStride();
+  T* resData = res.getData().data();
+
+  // Edges are followed with explicit stacks of the positions of the edge elements whose neighbours are still to be
+  //  checked; an element is marked as soon as it's pushed, so that each one is pushed at most once & the tracking is
+  //  linear. Candidates being scattered on busy images, neighbours are marked & pushed without branching, every one
+  //  being written to the top of the stack, which only grows if it was a candidate
+  const auto trackEdges = [&] (EdgeStack& edgePositions, std::size_t heightBegin, std::size_t heightEnd) {
+    std::size_t edgeCount = edgePositions.size();
+
+    while (edgeCount > 0) {
+      const std::size_t heightIndex = edgePositions[edgeCount - 1].first;
+      const std::size_t widthIndex = edgePositions[edgeCount - 1].second;
+      --edgeCount;
+
+      if (edgePositions.size() < edgeCount + 9)
+        edgePositions.resize(2 * (edgeCount + 9));
+
+      const std::size_t firstNeighbourRow = (heightIndex > heightBegin ? heightIndex - 1 : heightIndex);
+      const std::size_t lastNeighbourRow = std::min(heightIndex + 1, heightEnd - 1);
+      const std::size_t firstNeighbourColumn = (widthIndex > 0 ? widthIndex - 1 : widthIndex);
+      const std::size_t lastNeighbourColumn = std::min(widthIndex + 1, width - 1);
+
+      for (std::size_t neighbourRow = firstNeighbourRow; neighbourRow <= lastNeighbourRow; ++neighbourRow) {
+        T* resRow = resData + neighbourRow * resStride;
+
+        for (std::size_t neighbourColumn = firstNeighbourColumn; neighbourColumn <= lastNeighbourColumn; ++neighbourColumn) {
+          const bool isCandidate = (resRow[neighbourColumn] == WeakEdgeValue);
+
+          resRow[neighbourColumn] = (isCandidate ? T(ConnectedEdgeValue) : resRow[neighbourColumn]);
+          edgePositions[edgeCount] = EdgePosition(neighbourRow, neighbourColumn);
+          edgeCount += isCandidate;
+        }
+      }
+    }
 
-  Matrix<float> res = changeColorspace<ARCV_COLORSPACE_GRAY>(mat);
-  const Matrix<float> temp = res;
-
-  for (unsigned int heightIndex = 0; heightIndex < temp.getHeight(); ++heightIndex) {
-    for (unsigned int widthIndex = 0; widthIndex < temp.getWidth(); ++widthIndex) {
-      const std::size_t tempIndex = heightIndex * temp.getWidth() + widthIndex;
-      float resVal = 0.f;
-
-      if (temp[tempIndex] >= *upperBounds.begin()) {
-        resVal = 255;
-      } else {
-        if (temp[tempIndex] >= *lowerBounds.begin()) {
-          for (int8_t roundHeightIndex = -1; roundHeightIndex <= 1; ++roundHeightIndex) {
-            for (int8_t roundWidthIndex = -1; roundWidthIndex <= 1; ++roundWidthIndex) {
-              const std::size_t correspHeightIndex = heightIndex + roundHeightIndex;
-              const std::size_t correspWidthIndex = widthIndex + roundWidthIndex;
-
-              if ((correspHeightIndex < res.getHeight() && correspWidthIndex < res.getWidth())
-                  && temp[correspHeightIndex * temp.getWidth() + correspWidthIndex] >= *upperBounds.begin()) {
-                resVal = 255;
-                break;
-              }
-            }
+    edgePositions.clear();
+  };
+
+  // Rows are split into as many bands as threads, each one classified & tracked on its own: elements are marked as
+  //  strong edges (255), weak candidates or neither (0), edges being then followed without leaving the band. Rows
+  //  holding no candidate are remembered, strong edges having nothing to be followed to around them
+  // Those flags are drawn from the current memory arena, if any, & the stacks are kept by each thread
+  const std::size_t bandCount = std::min(height, ThreadPool::getInstance().getThreadCount());
+  const auto getBandBegin = [height, bandCount] (std::size_t bandIndex) { return bandIndex * height / bandCount; };
+  std::vector<uint8_t, AlignedAllocator<uint8_t>> candidateRows(height, 0, AlignedAllocator<uint8_t>(MemoryArena::getCurrent()));
+
+  ThreadPool::getInstance().parallelFor(bandCount, [&] (std::size_t bandBegin, std::size_t bandEnd) {
+    EdgeStack& edgePositions = getScratchVector<EdgeStackBuffer, EdgePosition>();
+
+    for (std::size_t bandIndex = bandBegin; bandIndex < bandEnd; ++bandIndex) {
+      const std::size_t heightBegin = getBandBegin(bandIndex);
+      const std::size_t heightEnd = getBandBegin(bandIndex + 1);
+
+      for (std::size_t heightIndex = heightBegin; heightIndex < heightEnd; ++heightIndex) {
+        const T* tempRow = temp.getData().data() + heightIndex * temp.getStride();
+        T* resRow = resData + heightIndex * resStride;
+        bool hasCandidates = false;
+
+        for (std::size_t widthIndex = 0; widthIndex < width; ++widthIndex) {
+          const float val = tempRow[widthIndex];
+          const bool isCandidate = (val >= lowerBound && val < upperBound);
+
+          resRow[widthIndex] = T(val >= upperBound ? 255 : (isCandidate ? WeakEdgeValue : 0));
+          hasCandidates |= isCandidate;
+        }
+
+        candidateRows[heightIndex] = hasCandidates;
+      }
+
+      for (std::size_t heightIndex = heightBegin; heightIndex < heightEnd; ++heightIndex) {
+        if (!candidateRows[heightIndex] && (heightIndex == heightBegin || !candidateRows[heightIndex - 1])
+                                        && (heightIndex + 1 == heightEnd || !candidateRows[heightIndex + 1]))
+          continue;
+
+        const T* resRow = resData + heightIndex * resStride;
+
+        for (std::size_t widthIndex = 0; widthIndex < width; ++widthIndex) {
+          if (resRow[widthIndex] == 255) {
+            edgePositions.emplace_back(heightIndex, widthIndex);
+            trackEdges(edgePositions, heightBegin, heightEnd);
           }
         }
       }
+    }
+  });
+
+  // Edges crossing the bands' boundaries are merged by resuming the tracking over the whole matrix, from the edge
+  //  elements of each boundary row facing candidates
+  EdgeStack& edgePositions = getScratchVector<EdgeStackBuffer, EdgePosition>();
 
-      res[tempIndex] = resVal;
+  for (std::size_t bandIndex = 1; bandIndex < bandCount; ++bandIndex) {
+    const std::size_t lowerRow = getBandBegin(bandIndex);
+
+    for (std::size_t heightIndex = lowerRow - 1; heightIndex <= lowerRow; ++heightIndex) {
+      const std::size_t facingRow = (heightIndex < lowerRow ? lowerRow : lowerRow - 1);
+
+      if (!candidateRows[facingRow])
+        continue;
+
+      const T* resRow = resData + heightIndex * resStride;
+
+      for (std::size_t widthIndex = 0; widthIndex < width; ++widthIndex) {
+        if (resRow[widthIndex] == 255 || resRow[widthIndex] == ConnectedEdgeValue)
+          edgePositions.emplace_back(heightIndex, widthIndex);
+      }
     }
   }
 
-  return res;
+  trackEdges(edgePositions, 0, height);
+
+  // Candidates left unmarked aren't connected to any strong edge
+  ThreadPool::getInstance().parallelFor(height, [&] (std::size_t begin, std::size_t end) {
+    for (std::size_t heightIndex = begin; heightIndex < end; ++heightIndex) {
+      if (!candidateRows[heightIndex])
+        continue;
+
+      T* resRow = resData + heightIndex * resStride;
+
+      for (std::size_t widthIndex = 0; widthIndex < width; ++widthIndex) {
+        if (resRow[widthIndex] == WeakEdgeValue)
+          resRow[widthIndex] = 0;
+        else if (resRow[widthIndex] == ConnectedEdgeValue)
+          resRow[widthIndex] = 255;
+      }
+    }
+  });
 }
 
-template <>
-Matrix<> threshold<ARCV_THRESH_TYPE_HYSTERESIS_AUTO>(const Matrix<>& mat, std::initializer_list<float> lowerBounds,
-                                                                          std::initializer_list<float> upperBounds) {
-  const float deriv = mat.computeStandardDeviations()[0];
+template <typename T>
+void computeThreshold(const Matrix<T>& mat, Matrix<T>& res, std::initializer_list<float>,
+                      std::initializer_list<float>, ThreshTag<ARCV_THRESH_TYPE_HYSTERESIS_AUTO>) {
+  // The standard deviation is taken from the statistics directly, integer ones being otherwise truncated; neither the
+  //  mean nor the differences to it are rounded, unlike before the statistics were gathered in a single pass
+  const float deriv = static_cast<float>(std::sqrt(mat.computeStatistics()[0].variance));
 
-  return threshold<ARCV_THRESH_TYPE_HYSTERESIS>(mat, { deriv }, { deriv + 30 });
+  computeThreshold(mat, res, { deriv }, { deriv + 30 }, ThreshTag<ARCV_THRESH_TYPE_HYSTERESIS>());
 }
 
+} // namespace
+
+template <ThreshType Thresh, typename T>
+void threshold(const Matrix<T>& mat, Matrix<T>& res, std::initializer_list<float> lowerBounds,
+                                                     std::initializer_list<float> upperBounds) {
+  computeThreshold(mat, res, lowerBounds, upperBounds, ThreshTag<Thresh>());
+}
+
+template void threshold<ARCV_THRESH_TYPE_BINARY>(const Matrix<float>& mat, Matrix<float>& res,
+                                                 std::initializer_list<float> lowerBounds, std::initializer_list<float> upperBounds);
+template void threshold<ARCV_THRESH_TYPE_BINARY>(const Matrix<uint8_t>& mat, Matrix<uint8_t>& res,
+                                                 std::initializer_list<float> lowerBounds, std::initializer_list<float> upperBounds);
+template void threshold<ARCV_THRESH_TYPE_BINARY>(const Matrix<int16_t>& mat, Matrix<int16_t>& res,
+                                                 std::initializer_list<float> lowerBounds, std::initializer_list<float> upperBounds);
+template void threshold<ARCV_THRESH_TYPE_HYSTERESIS>(const Matrix<float>& mat, Matrix<float>& res,
+                                                     std::initializer_list<float> lowerBounds, std::initializer_list<float> upperBounds);
+template void threshold<ARCV_THRESH_TYPE_HYSTERESIS>(const Matrix<uint8_t>& mat, Matrix<uint8_t>& res,
+                                                     std::initializer_list<float> lowerBounds, std::initializer_list<float> upperBounds);
+template void threshold<ARCV_THRESH_TYPE_HYSTERESIS>(const Matrix<int16_t>& mat, Matrix<int16_t>& res,
+                                                     std::initializer_list<float> lowerBounds, std::initializer_list<float> upperBounds);
+template void threshold<ARCV_THRESH_TYPE_HYSTERESIS_AUTO>(const Matrix<float>& mat, Matrix<float>& res,
+                                                          std::initializer_list<float> lowerBounds, std::initializer_list<float> upperBounds);
+template void threshold<ARCV_THRESH_TYPE_HYSTERESIS_AUTO>(const Matrix<uint8_t>& mat, Matrix<uint8_t>& res,
+                                                          std::initializer_list<float> lowerBounds, std::initializer_list<float> upperBounds);
+template void threshold<ARCV_THRESH_TYPE_HYSTERESIS_AUTO>(const Matrix<int16_t>& mat, Matrix<int16_t>& res,
+                                                          std::initializer_list<float> lowerBounds, std::initializer_list<float> upperBounds);
+
 } // namespace Image
 
 } // namespace Arcv
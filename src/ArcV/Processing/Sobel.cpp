@@ -2,47 +2,86 @@
 #define _USE_MATH_DEFINES
 #endif
 
+#include "ArcV/Math/StaticKernel.hpp"
 #include "ArcV/Processing/Sobel.hpp"
 
 namespace Arcv {
 
-Sobel::Sobel(const Matrix<>& mat) {
-  sobelMat = Matrix<>(mat.getWidth(), mat.getHeight(), mat.getChannelCount(), mat.getImgBitDepth(), mat.getColorspace());
-  horizontalGradient = computeHorizontalSobelOperator(mat);
-  verticalGradient = computeVerticalSobelOperator(mat);
+template <typename T>
+Sobel<T>::Sobel(const MatrixView<const T>& mat, const AlignedAllocator<GradientType>& allocator)
+  : sobelMat(allocator), horizontalGradient(allocator), verticalGradient(allocator) {
+  sobelMat.reshape(mat.getWidth(), mat.getHeight(), mat.getChannelCount(), mat.getImgBitDepth(), mat.getColorspace(), false);
+  computeHorizontalSobelOperator(mat, horizontalGradient);
+  computeVerticalSobelOperator(mat, verticalGradient);
 
-  for (std::size_t i = 0; i < mat.getData().size(); ++i)
-    sobelMat.getData()[i] = std::sqrt(horizontalGradient.getData()[i] * horizontalGradient.getData()[i]
-                                      + verticalGradient.getData()[i] * verticalGradient.getData()[i]);
+  for (std::size_t i = 0; i < sobelMat.getData().size(); ++i) {
+    const float horizVal = horizontalGradient.getData()[i];
+    const float vertVal = verticalGradient.getData()[i];
+
+    sobelMat.getData()[i] = Simd::saturateCast<GradientType>(std::sqrt(horizVal * horizVal + vertVal * vertVal));
+  }
+}
+
+template <typename T>
+Matrix<float> Sobel<T>::computeGradientDirection() const {
+  Matrix<float> res;
+  computeGradientDirection(res);
+
+  return res;
 }
 
-Matrix<> Sobel::computeGradientDirection() const {
-  Matrix<> res(sobelMat.getWidth(),
-               sobelMat.getHeight(),
-               sobelMat.getChannelCount(),
-               sobelMat.getImgBitDepth(),
-               sobelMat.getColorspace());
+template <typename T>
+void Sobel<T>::computeGradientDirection(Matrix<float>& res) const {
+  res.reshape(sobelMat.getWidth(),
+              sobelMat.getHeight(),
+              sobelMat.getChannelCount(),
+              sobelMat.getImgBitDepth(),
+              sobelMat.getColorspace(),
+              false);
+
+  for (std::size_t i = 0; i < sobelMat.getData().size(); ++i) {
+    res[i] = 180.f + std::atan2(static_cast<float>(verticalGradient[i]), static_cast<float>(horizontalGradient[i]))
+                     * (180.f / static_cast<float>(M_PI));
+  }
+}
 
-  for (std::size_t i = 0; i < sobelMat.getData().size(); ++i)
-    res[i] = 180.f + std::atan2(verticalGradient[i], horizontalGradient[i]) * (180.f / static_cast<float>(M_PI));
+template <typename T>
+Matrix<typename Sobel<T>::GradientType> Sobel<T>::computeHorizontalSobelOperator(const MatrixView<const T>& mat) {
+  Matrix<GradientType> res;
+  computeHorizontalSobelOperator(mat, res);
 
   return res;
 }
 
-Matrix<> Sobel::computeHorizontalSobelOperator(const Matrix<>& mat) {
-  const Matrix<float> horizKernel = {{ 1.f, 0.f, -1.f },
-                                     { 2.f, 0.f, -2.f },
-                                     { 1.f, 0.f, -1.f }};
+template <typename T>
+void Sobel<T>::computeHorizontalSobelOperator(const MatrixView<const T>& mat, Matrix<GradientType>& res) {
+  // Its zero column skipped, the kernel costs 6 additions & shifts per element, fewer than its separated passes
+  using Kernel = StaticKernel<0, 1, 0, -1,
+                                 2, 0, -2,
+                                 1, 0, -1>;
+
+  convolve(mat, Kernel(), res);
+}
+
+template <typename T>
+Matrix<typename Sobel<T>::GradientType> Sobel<T>::computeVerticalSobelOperator(const MatrixView<const T>& mat) {
+  Matrix<GradientType> res;
+  computeVerticalSobelOperator(mat, res);
 
-  return mat.convolve(horizKernel);
+  return res;
 }
 
-Matrix<> Sobel::computeVerticalSobelOperator(const Matrix<>& mat) {
-  const Matrix<float> vertKernel = {{  1.f,  2.f,  1.f },
-                                    {  0.f,  0.f,  0.f },
-                                    { -1.f, -2.f, -1.f }};
+template <typename T>
+void Sobel<T>::computeVerticalSobelOperator(const MatrixView<const T>& mat, Matrix<GradientType>& res) {
+  using Kernel = StaticKernel<0,  1,  2,  1,
+                                  0,  0,  0,
+                                 -1, -2, -1>;
 
-  return mat.convolve(vertKernel);
+  convolve(mat, Kernel(), res);
 }
 
+template class Sobel<float>;
+template class Sobel<uint8_t>;
+template class Sobel<int16_t>;
+
 } // namespace Arcv
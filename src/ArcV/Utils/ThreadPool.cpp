@@ -0,0 +1,92 @@
+#include <algorithm>
+
+#include "ArcV/Utils/ThreadPool.hpp"
+
+namespace Arcv {
+
+thread_local bool ThreadPool::isWorker = false;
+
+ThreadPool::ThreadPool(std::size_t threadCount) {
+  for (std::size_t workerIndex = 1; workerIndex < threadCount; ++workerIndex)
+    workers.emplace_back(&ThreadPool::processTasks, this);
+}
+
+ThreadPool& ThreadPool::getInstance() {
+  static ThreadPool threadPool;
+  return threadPool;
+}
+
+void ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t, std::size_t)>& function) {
+  const std::size_t rangeCount = std::min(count, getThreadCount());
+
+  if (rangeCount <= 1 || isWorker) {
+    if (count > 0)
+      function(0, count);
+    return;
+  }
+
+  const std::size_t rangeSize = count / rangeCount;
+  const std::size_t remainder = count % rangeCount;
+
+  std::mutex doneMutex;
+  std::condition_variable doneCondition;
+  std::size_t remainingRanges = rangeCount - 1;
+
+  // The first range is kept for the calling thread, the others being given to the workers
+  {
+    std::lock_guard<std::mutex> lock(tasksMutex);
+
+    for (std::size_t rangeIndex = 1; rangeIndex < rangeCount; ++rangeIndex) {
+      const std::size_t begin = rangeIndex * rangeSize + std::min(rangeIndex, remainder);
+      const std::size_t end = begin + rangeSize + (rangeIndex < remainder ? 1 : 0);
+
+      tasks.emplace([&function, &doneMutex, &doneCondition, &remainingRanges, begin, end] () {
+        function(begin, end);
+
+        std::lock_guard<std::mutex> doneLock(doneMutex);
+        if (--remainingRanges == 0)
+          doneCondition.notify_one();
+      });
+    }
+  }
+  tasksCondition.notify_all();
+
+  function(0, rangeSize + (remainder > 0 ? 1 : 0));
+
+  std::unique_lock<std::mutex> doneLock(doneMutex);
+  doneCondition.wait(doneLock, [&remainingRanges] () { return remainingRanges == 0; });
+}
+
+void ThreadPool::processTasks() {
+  isWorker = true;
+
+  while (true) {
+    std::function<void()> task;
+
+    {
+      std::unique_lock<std::mutex> lock(tasksMutex);
+      tasksCondition.wait(lock, [this] () { return stopping || !tasks.empty(); });
+
+      if (stopping && tasks.empty())
+        return;
+
+      task = std::move(tasks.front());
+      tasks.pop();
+    }
+
+    task();
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(tasksMutex);
+    stopping = true;
+  }
+  tasksCondition.notify_all();
+
+  for (std::thread& worker : workers)
+    worker.join();
+}
+
+} // namespace Arcv
@@ -178,7 +178,21 @@ void Window::mapImage(const Matrix<uint8_t>& mat) const {
       break;
   }
 
-  glTexImage2D(GL_TEXTURE_2D, 0, imgFormat, mat.getWidth(), mat.getHeight(), 0, imgFormat, GL_UNSIGNED_BYTE, mat.getData().data());
+  // Rows are tightly packed or padded, in which case they may not hold a whole amount of pixels
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+  if (mat.getStride() % mat.getChannelCount() == 0) {
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<GLint>(mat.getStride() / mat.getChannelCount()));
+    glTexImage2D(GL_TEXTURE_2D, 0, imgFormat, mat.getWidth(), mat.getHeight(), 0, imgFormat, GL_UNSIGNED_BYTE, mat.getData().data());
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+  } else {
+    glTexImage2D(GL_TEXTURE_2D, 0, imgFormat, mat.getWidth(), mat.getHeight(), 0, imgFormat, GL_UNSIGNED_BYTE, nullptr);
+
+    for (std::size_t heightIndex = 0; heightIndex < mat.getHeight(); ++heightIndex) {
+      glTexSubImage2D(GL_TEXTURE_2D, 0, 0, static_cast<GLint>(heightIndex), mat.getWidth(), 1,
+                      imgFormat, GL_UNSIGNED_BYTE, &mat.getData()[heightIndex * mat.getStride()]);
+    }
+  }
 }
 
 bool Window::show() const {
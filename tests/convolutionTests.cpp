@@ -0,0 +1,49 @@
+#include <cstdlib>
+#include <iostream>
+#include <algorithm>
+
+#include "ArcV/Math/Matrix.hpp"
+
+namespace {
+
+bool check(bool condition, const char* message) {
+  if (!condition)
+    std::cerr << "Failed: " << message << std::endl;
+
+  return condition;
+}
+
+// Normalized box kernels, applied in fixed point as a row & a column kernel, must keep uniform integer matrices unchanged
+template <typename T>
+bool keepsUniformValue(T value) {
+  bool success = true;
+
+  for (std::size_t kernelSize = 3; kernelSize <= 9; kernelSize += 2) {
+    Arcv::Matrix<float> boxKernel(kernelSize, kernelSize);
+    std::fill(boxKernel.getData().begin(), boxKernel.getData().end(), 1.f / static_cast<float>(kernelSize * kernelSize));
+
+    Arcv::Matrix<T> mat(32, 24, 1, 8, ARCV_COLORSPACE_GRAY, false);
+    std::fill(mat.getData().begin(), mat.getData().end(), value);
+
+    Arcv::Matrix<T> res;
+    Arcv::convolve(Arcv::MatrixView<const T>(mat), boxKernel, res, ARCV_BORDER_TYPE_REPLICATE);
+
+    success &= check(std::all_of(res.getData().begin(), res.getData().end(), [value] (T elt) { return elt == value; }),
+                     "box kernel changed a uniform matrix");
+  }
+
+  return success;
+}
+
+} // namespace
+
+int main() {
+  bool success = true;
+
+  success &= keepsUniformValue<uint8_t>(255);
+  success &= keepsUniformValue<uint8_t>(1);
+  success &= keepsUniformValue<int16_t>(32767);
+  success &= keepsUniformValue<int16_t>(-1000);
+
+  return (success ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,57 @@
+#include <cstdlib>
+#include <iostream>
+
+#include "ArcV/Math/IntegralImage.hpp"
+
+namespace {
+
+bool check(bool condition, const char* message) {
+  if (!condition)
+    std::cerr << "Failed: " << message << std::endl;
+
+  return condition;
+}
+
+// Rows are split among threads, whose count rarely divides the height: every rectangle's sum must match a naive one
+bool matchesNaiveSums(std::size_t width, std::size_t height) {
+  Arcv::Matrix<float> mat(width, height, 2, 32, ARCV_COLORSPACE_GRAY_ALPHA, false);
+
+  for (std::size_t eltIndex = 0; eltIndex < mat.getData().size(); ++eltIndex)
+    mat.getData()[eltIndex] = static_cast<float>(eltIndex % 13);
+
+  const Arcv::IntegralImage<float> integralImg(Arcv::MatrixView<const float>(mat), true);
+  bool success = true;
+
+  for (uint8_t chan = 0; chan < mat.getChannelCount(); ++chan) {
+    for (std::size_t heightBegin = 0; heightBegin <= height; ++heightBegin) {
+      double sum = 0.0;
+      double squaredSum = 0.0;
+
+      // Rectangles span the whole width, from a given row down to the last one
+      for (std::size_t heightIndex = heightBegin; heightIndex < height; ++heightIndex) {
+        for (std::size_t widthIndex = 0; widthIndex < width; ++widthIndex) {
+          const double value = mat.getData()[(heightIndex * width + widthIndex) * mat.getChannelCount() + chan];
+          sum += value;
+          squaredSum += value * value;
+        }
+      }
+
+      success &= check(integralImg.computeSum(0, width, heightBegin, height, chan) == sum, "integral image sum differs");
+      success &= check(integralImg.computeSquaredSum(0, width, heightBegin, height, chan) == squaredSum,
+                       "integral image squared sum differs");
+    }
+  }
+
+  return success;
+}
+
+} // namespace
+
+int main() {
+  bool success = true;
+
+  for (std::size_t height = 1; height <= 40; ++height)
+    success &= matchesNaiveSums(3, height);
+
+  return (success ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,69 @@
+#include <cstdlib>
+#include <iostream>
+#include <algorithm>
+
+#include "ArcV/Math/Matrix.hpp"
+#include "ArcV/Math/MemoryArena.hpp"
+
+namespace {
+
+bool check(bool condition, const char* message) {
+  if (!condition)
+    std::cerr << "Failed: " << message << std::endl;
+
+  return condition;
+}
+
+bool holdsOnly(const Arcv::Matrix<float>& mat, float value) {
+  return std::all_of(mat.getData().begin(), mat.getData().end(), [value] (float elt) { return elt == value; });
+}
+
+// Fills the arena's memory again once reset, overwriting whatever may still point to it
+void overwriteArena(Arcv::MemoryArena& arena) {
+  arena.reset();
+
+  Arcv::Matrix<float> arenaMat{ Arcv::AlignedAllocator<float>(&arena) };
+  arenaMat.reshape(16, 16, 1, 8, ARCV_COLORSPACE_GRAY, false);
+  std::fill(arenaMat.getData().begin(), arenaMat.getData().end(), 3.f);
+}
+
+} // namespace
+
+int main() {
+  Arcv::MemoryArena arena;
+  bool success = true;
+
+  // Moving an arena-backed matrix into a heap-backed one copies its elements to the heap
+  Arcv::Matrix<float> movedMat(16, 16);
+  {
+    Arcv::Matrix<float> arenaMat{ Arcv::AlignedAllocator<float>(&arena) };
+    arenaMat.reshape(16, 16, 1, 8, ARCV_COLORSPACE_GRAY, false);
+    std::fill(arenaMat.getData().begin(), arenaMat.getData().end(), 2.f);
+
+    movedMat = std::move(arenaMat);
+  }
+
+  success &= check(movedMat.getData().get_allocator().getArena() == nullptr, "moved matrix took the arena's allocator");
+  overwriteArena(arena);
+  success &= check(holdsOnly(movedMat, 2.f), "moved matrix points to the arena's memory after reset");
+
+  // Assigning an expression of another size evaluates it in a new matrix, which is then moved
+  Arcv::Matrix<float> exprMat(4, 4);
+  {
+    Arcv::Matrix<float> arenaMat{ Arcv::AlignedAllocator<float>(&arena) };
+    arenaMat.reshape(16, 16, 1, 8, ARCV_COLORSPACE_GRAY, false);
+    std::fill(arenaMat.getData().begin(), arenaMat.getData().end(), 2.f);
+
+    exprMat = arenaMat * 2.f;
+  }
+
+  overwriteArena(arena);
+  success &= check(exprMat.getWidth() == 16 && holdsOnly(exprMat, 4.f), "assigned matrix points to the arena's memory after reset");
+
+  // Arena-backed matrices stay in their arena when assigned
+  Arcv::Matrix<float> arenaMat{ Arcv::AlignedAllocator<float>(&arena) };
+  arenaMat = Arcv::Matrix<float>(8, 8);
+  success &= check(arenaMat.getData().get_allocator().getArena() == &arena, "arena-backed matrix left its arena");
+
+  return (success ? EXIT_SUCCESS : EXIT_FAILURE);
+}
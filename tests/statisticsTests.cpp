@@ -0,0 +1,61 @@
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+#include "ArcV/Math/Matrix.hpp"
+
+namespace {
+
+bool check(bool condition, const char* message) {
+  if (!condition)
+    std::cerr << "Failed: " << message << std::endl;
+
+  return condition;
+}
+
+bool isClose(double value, double expected) {
+  return std::abs(value - expected) <= 1e-9 * std::max(1.0, std::abs(expected));
+}
+
+// Rows are long enough for every row to be worth a range, so that ranges are as many as threads & rarely divide the
+//  height: statistics merged from them must match naive ones
+bool matchesNaiveStatistics(std::size_t height) {
+  const std::size_t width = 1 << 16;
+  Arcv::Matrix<float> mat(width, height, 1, 32, ARCV_COLORSPACE_GRAY, false);
+
+  for (std::size_t eltIndex = 0; eltIndex < mat.getData().size(); ++eltIndex)
+    mat.getData()[eltIndex] = static_cast<float>((eltIndex * 7 + eltIndex / width) % 11);
+
+  double sum = 0.0;
+  double squaredSum = 0.0;
+
+  for (float value : mat.getData()) {
+    sum += value;
+    squaredSum += static_cast<double>(value) * value;
+  }
+
+  const double pixelCount = static_cast<double>(width * height);
+  const double mean = sum / pixelCount;
+  const double variance = squaredSum / pixelCount - mean * mean;
+
+  const Arcv::ChannelStatistics<float> stats = mat.computeStatistics().front();
+  bool success = true;
+
+  success &= check(stats.min == 0.f && stats.max == 10.f, "statistics' bounds differ");
+  success &= check(stats.sum == sum, "statistics' sum differs");
+  success &= check(isClose(stats.mean, mean), "statistics' mean differs");
+  success &= check(isClose(stats.variance, variance), "statistics' variance differs");
+
+  return success;
+}
+
+} // namespace
+
+int main() {
+  bool success = true;
+
+  for (std::size_t height = 1; height <= 40; ++height)
+    success &= matchesNaiveStatistics(height);
+
+  return (success ? EXIT_SUCCESS : EXIT_FAILURE);
+}